@@ -2,136 +2,31 @@
 #include <cmath>
 #include <iomanip>
 
+#include "../include/function.h"
+#include "../include/integration.h"
+#include "../include/parallel.h"
+#include "../include/refinement.h"
+#include "../include/romberg.h"
+#include "../include/chebyshev.h"
+#include "../include/expression.h"
+#include "../include/oscillatory.h"
+
 using namespace std;
 
-// Функция, которую интегрируем для 1 и 3 задания
-
-double f(double x) 
-{
-// Вычисляем значение функции sin(x² + 2.5) / (x³ + 3)
-return sin(x * x + 2.5) / (x * x * x + 3);
-}
-
-// Метод трапеций для вычисления интеграла (использует прямые линии, тем самым разбивает фигуру на трапеции)
-double trapezoid(double start, double end, int parts) // parts - на сколько частей разбиваем интервал
-{
-// Вычисляем ширину одного отрезка
-double step = (end - start) / parts; // Это шаг, с которым мы движемся от одной точки к другой.
-// Начальная сумма - полусумма значений на краях
-double total = (f(start) + f(end)) / 2;
-
-// Суммируем значения функции во всех внутренних точках
-for (int i = 1; i < parts; i++) 
-{
-total += f(start + i * step); //вычисление координат в текущей точке. Пр:i = 1: 0.4 + 1 × 0.3 = 0.7
-} // i * step - смещение от начала
-
-// Умножаем накопленную сумму на ширину шага и получаем приближённое значение интеграла.
-return total * step;
-}
-
-// Метод Симпсона для вычисления интеграла (использует параболы для приближения кривой. Это как если бы мы соединяли точки не отрезками, а плавными изгибами)
-double simpson(double start, double end, int parts) 
-{
-// Метод Симпсона требует четного числа отрезков (работаем с тройками точек)
-if (parts % 2 != 0) 
-{
-parts++; // Если передали нечётное - делаем чётным
-} 
-// Вычисляем ширину одного отрезка
-double step = (end - start) / parts;
-// Начальная сумма - значения на краях
-double total = f(start) + f(end);
-
-// Суммируем значения с разными коэффициентами
-for (int i = 1; i < parts; i++) 
-{
-// Для четных точек коэффициент - 2, для нечетных - 4
-if (i % 2 == 0) 
-{
-total += 2 * f(start + i * step);
-} else 
-{
-total += 4 * f(start + i * step);
-}
-}
-
-// Умножаем на шаг и делим на 3 по формуле Симпсона
-return total * step / 3;
-}
-
-// Метод прямоугольников (левых)
-double rectangles(double start, double end, int parts) 
-{
-// Вычисляем ширину одного прямоугольника
-double step = (end - start) / parts;
-// Сумма площадей прямоугольников
-double total = 0;
-
-// Суммируем площади всех прямоугольников
-for (int i = 0; i < parts; i++) 
-{
-// Вычисляем x-координату левой стороны прямоугольника
-double x = start + i * step;
-// Добавляем высоту прямоугольника (значение функции)
-total += f(x);
-}
-
-// Умножаем сумму высот на ширину для получения общей площади
-return total * step;
-}
-
-
-
-
-
-// Функция, которую интегрируем для 2 задания
-
-double f2(double x) 
-{
-// Вычисляем значение функции 1/√(x³ + 1)
-return 1.0 / sqrt(x * x * x + 1);
-}
-
-// Метод прямоугольников (левых)
-double T_rectangles(double start, double end, int parts) 
-{
-// Вычисляем ширину одного прямоугольника
-double step = (end - start) / parts;
-// Сумма площадей прямоугольников
-double total = 0;
-
-// Суммируем площади всех прямоугольников
-for (int i = 0; i < parts; i++) {
-// Вычисляем x-координату левой стороны прямоугольника
-double x = start + i * step;
-// Добавляем высоту прямоугольника (значение функции)
-total += f2(x);
-}
-
-// Умножаем сумму высот на ширину для получения общей площади
-return total * step;
-}
-
-// Метод трапеций
-double T_trapezoid(double start, double end, int parts) 
-	{
-	// Вычисляем ширину одной трапеции
-	double step = (end - start) / parts;
-	// Начальная сумма - полусумма значений на краях интервала
-	double total = (f2(start) + f2(end)) / 2;
-
-	// Суммируем значения функции во всех внутренних точках
-	for (int i = 1; i < parts; i++) {
-	// Вычисляем x-координату текущей точки
-	double x = start + i * step;
-	// Добавляем значение функции в текущей точке
-	total += f2(x);
-	}
+// Функция, которую интегрируем для 1 и 3 задания: sin(x² + 2.5) / (x³ + 3)
+const sine_function f;
 
-	// Умножаем сумму на шаг для получения общей площади
-	return total * step;
-	}
+// Функция, которую интегрируем для 2 задания: 1/√(x³ + 1)
+const inverse_root_function f2;
+
+// Методы трапеций, Симпсона и прямоугольников берутся из общего движка include/integration.h;
+// функция передаётся в них как параметр шаблона, поэтому отдельные копии T_* больше не нужны
+
+// Параллельное выполнение для циклов удвоения: при малом числе разбиений
+// всё считается в текущем потоке, при большом - в пуле потоков
+// (число потоков задаётся переменной окружения INTEGRATION_THREADS).
+// Воспроизводимое суммирование: результаты одинаковы до бита при любом числе потоков
+const integration::parallel_execution parallel(integration::summation_mode::reproducible);
 
 
 	int main() 
@@ -157,13 +52,15 @@ double T_trapezoid(double start, double end, int parts)
 	int count_trap = 0;          // Счетчик итераций
 
 	// Первое вычисление с начальным числом разбиений
-	old_trap = trapezoid(start, end, parts_trap); // старт, конец, разбиение
+	integration::refinement refine_trap(f, start, end, parts_trap, parallel); // функция, старт, конец, разбиение
+	old_trap = refine_trap.trapezoid();
 
 	// Цикл уточнения результата, чтобы подобраться к разнице в (1e - 6) между old_trap и new_trap
 	for (int i = 1; i <= 30; i++) // i <= 30, потому что не имеет смысла. точность не улучшится, а программа будет работать дольше 
 	{
-	parts_trap *= 2;                    // Удваиваем число разбиений
-	new_trap = trapezoid(start, end, parts_trap); // Новое вычисление
+	refine_trap.refine(); // Удваиваем число разбиений: вычисляются только новые узлы
+	parts_trap = refine_trap.parts();
+	new_trap = refine_trap.trapezoid(); // Новое вычисление
 	count_trap = i;                     // Запоминаем номер итерации
 
 	// Проверяем достигнута ли требуемая точность - 1e - 6
@@ -185,13 +82,16 @@ double T_trapezoid(double start, double end, int parts)
 	int count_simp = 0;          // Счетчик итераций
 
 	// Первое вычисление с начальным числом разбиений
-	old_simp = simpson(start, end, parts_simp);
+	integration::refinement refine_simp(f, start, end, parts_simp / 2, parallel);
+	refine_simp.refine(); // Симпсон на parts_simp частях строится из трапеций на parts_simp и parts_simp / 2
+	old_simp = refine_simp.simpson();
 
 	// Цикл уточнения результата
 	for (int i = 1; i <= 30; i++) 
 	{
-	parts_simp *= 2;                    // Удваиваем число разбиений
-	new_simp = simpson(start, end, parts_simp); // Новое вычисление
+	refine_simp.refine(); // Удваиваем число разбиений: вычисляются только новые узлы
+	parts_simp = refine_simp.parts();
+	new_simp = refine_simp.simpson(); // Новое вычисление
 	count_simp = i;                     // Запоминаем номер итерации
 
 	// Проверяем достигнута ли требуемая точность
@@ -206,6 +106,51 @@ double T_trapezoid(double start, double end, int parts)
 	cout << "Потребовалось итераций: " << count_simp << endl;
 	cout << "Финальное число разбиений: " << parts_simp << endl << endl;
 
+	// ВЫЧИСЛЕНИЕ МЕТОДОМ РОМБЕРГА (экстраполяция Ричардсона над теми же трапециями)
+	cout << "МЕТОД РОМБЕРГА:\n";
+	double romberg_precision = 1e-12; // Ромбергу хватает сотни узлов даже для такой точности
+	integration::romberg_result romb = integration::romberg(f, start, end, romberg_precision);
+
+	// Выводим результаты метода Ромберга
+	cout << "Значение интеграла: " << setprecision(12) << romb.value << setprecision(6) << endl;
+	cout << "Оценка погрешности: " << romb.error << endl;
+	cout << "Вычислений функции: " << romb.evaluations << endl << endl;
+
+	// ЗАПРОСЫ ПО ПОДОТРЕЗКАМ: чебышёвская аппроксимация f строится один раз,
+	// после чего интеграл по любому [x0, x1] внутри [start, end] стоит O(степени)
+	cout << "ЧЕБЫШЁВСКАЯ АППРОКСИМАЦИЯ:\n";
+	integration::chebyshev_surrogate surrogate(f, start, end);
+	integration::chebyshev_estimate whole = surrogate.integral(start, end);
+	integration::chebyshev_estimate window = surrogate.integral(1.0, 2.0);
+
+	// Выводим результаты по всему отрезку и по одному из подотрезков
+	cout << "Значение интеграла: " << setprecision(12) << whole.value << setprecision(6) << endl;
+	cout << "Оценка погрешности: " << whole.error << endl;
+	cout << "Интеграл по [1, 2]: " << setprecision(12) << window.value << setprecision(6) << endl;
+	cout << "Вычислений функции при построении: " << surrogate.evaluations() << endl << endl;
+
+	// ТА ЖЕ ФУНКЦИЯ, ЗАДАННАЯ СТРОКОЙ (компилируется в байт-код при запуске)
+	cout << "ФУНКЦИЯ, ЗАДАННАЯ СТРОКОЙ:\n";
+	integration::expression g("sin(x^2 + 2.5) / (x^3 + 3)");
+	double simpson_native = integration::simpson(f, start, end, 1000, parallel);
+	double simpson_text = integration::simpson(g, start, end, 1000, parallel);
+	cout << "Выражение: " << g.text() << " (команд: " << g.instructions() << ")" << endl;
+	cout << "Симпсон, n = 1000: " << setprecision(12) << simpson_text << setprecision(6) << endl;
+	cout << "Отличие от встроенной функции: " << fabs(simpson_text - simpson_native) << endl << endl;
+
+	// МЕТОД ЛЕВИНА: f = g(x) sin ω(x), g = 1/(x³ + 3), ω = x² + 2.5.
+	// Число вычислений не зависит от частоты, поэтому отрезок можно взять длинным
+	cout << "МЕТОД ЛЕВИНА (ОСЦИЛЛИРУЮЩАЯ ФУНКЦИЯ):\n";
+	auto amplitude = [](double x) { return 1.0 / (x * x * x + 3); };
+	auto phase = [](double x) { return x * x + 2.5; };
+	for (double right : {end, 100.0})
+	{
+	integration::oscillatory_result levin = integration::levin(amplitude, phase, start, right, 1e-12, 1e-12);
+	cout << "[" << start << ", " << right << "]: " << setprecision(12) << levin.sine << setprecision(6)
+	     << " (погрешность " << levin.error << ", вычислений функции: " << levin.evaluations << ")" << endl;
+	}
+	cout << endl;
+
 	// ВЫЧИСЛЕНИЕ МЕТОДОМ ПРЯМОУГОЛЬНИКОВ
 	cout << "МЕТОД ПРЯМОУГОЛЬНИКОВ:\n";
 	int parts_rect = 8;          // Начальное число разбиений
@@ -213,13 +158,15 @@ double T_trapezoid(double start, double end, int parts)
 	int count_rect = 0;          // Счетчик итераций
 
 	// Первое вычисление с начальным числом разбиений
-	old_rect = rectangles(start, end, parts_rect);
+	integration::refinement refine_rect(f, start, end, parts_rect, parallel);
+	old_rect = refine_rect.left_rectangles();
 
 	// Цикл уточнения результата
 	for (int i = 1; i <= 30; i++) 
 	{
-	parts_rect *= 2;                    // Удваиваем число разбиений
-	new_rect = rectangles(start, end, parts_rect); // Новое вычисление
+	refine_rect.refine(); // Удваиваем число разбиений: вычисляются только новые узлы
+	parts_rect = refine_rect.parts();
+	new_rect = refine_rect.left_rectangles(); // Новое вычисление
 	count_rect = i;                     // Запоминаем номер итерации
 
 	// Проверяем достигнута ли требуемая точность
@@ -254,12 +201,14 @@ double T_trapezoid(double start, double end, int parts)
 	int T_count_rect = 0;          // Счетчик итераций
 
 	// Первое вычисление с начальным числом разбиений
-	T_old_rect = T_rectangles(T_start, T_end, T_parts_rect);
+	integration::refinement T_refine_rect(f2, T_start, T_end, T_parts_rect, parallel);
+	T_old_rect = T_refine_rect.left_rectangles();
 
 	// Цикл уточнения результата
 	for (int i = 1; i <= 30; i++) {
-	T_parts_rect *= 2;                    // Удваиваем число разбиений
-	T_new_rect = T_rectangles(T_start, T_end, T_parts_rect); // Новое вычисление
+	T_refine_rect.refine(); // Удваиваем число разбиений: вычисляются только новые узлы
+	T_parts_rect = T_refine_rect.parts();
+	T_new_rect = T_refine_rect.left_rectangles(); // Новое вычисление
 	T_count_rect = i;                     // Запоминаем номер итерации
 
 	// Проверяем достигнута ли требуемая точность
@@ -281,13 +230,15 @@ double T_trapezoid(double start, double end, int parts)
 	int T_count_trap = 0;          // Счетчик итераций
 
 	// Первое вычисление с начальным числом разбиений
-	T_old_trap = T_trapezoid(T_start, T_end, T_parts_trap);
+	integration::refinement T_refine_trap(f2, T_start, T_end, T_parts_trap, parallel);
+	T_old_trap = T_refine_trap.trapezoid();
 
 	// Цикл уточнения результата
 	for (int i = 1; i <= 30; i++) 
 	{
-	T_parts_trap *= 2;                    // Удваиваем число разбиений
-	T_new_trap = T_trapezoid(T_start, T_end, T_parts_trap); // Новое вычисление
+	T_refine_trap.refine(); // Удваиваем число разбиений: вычисляются только новые узлы
+	T_parts_trap = T_refine_trap.parts();
+	T_new_trap = T_refine_trap.trapezoid(); // Новое вычисление
 	T_count_trap = i;                     // Запоминаем номер итерации
 
 	// Проверяем достигнута ли требуемая точность
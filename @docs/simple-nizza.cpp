@@ -3,6 +3,9 @@
 #include <iomanip>
 #include <limits>
 
+#include "../include/function.h"
+#include "../include/integration.h"
+
 using namespace std;
 
 const double PI = acos(-1.0);
@@ -12,24 +15,10 @@ const int N_DEFAULT = 5; // для методов на интервале A
 const int M_DEFAULT = 8; // для метода трапеций на интервале B
 
 // Функция f(x) = 1 / cos(x)
-double f(double x) 
-{
-    double c = cos(x);
-    if (abs(c) < 1e-12) 
-    {
-        // Возвращаем бесконечность, если cos(x) близок к нулю
-        return numeric_limits<double>::infinity();
-    }
-    return 1.0 / c;
-}
+const secant_function f;
 
 // Первообразная: F(x) = ln |sec x + tg x|, эквивалентно ln|tg(x/2 + pi/4)| (для x в [-pi/2, pi/2])
-double F(double x) 
-{
-    double sec = 1.0 / cos(x);
-    double tan = sin(x) / cos(x);
-    return log(abs(sec + tan));
-}
+const secant_antiderivative F;
 
 // Точное значение интеграла на [a, b]
 double exact_integral(double a, double b) 
@@ -37,72 +26,63 @@ double exact_integral(double a, double b)
     return F(b) - F(a);
 }
 
-// Левое правило прямоугольников
-double left_rectangles(double a, double b, int n) 
+// Обёртка над f для правил из include/integration.h: запоминает первый узел, в котором f(x) не конечна
+auto checked_f(double& singular_x) 
 {
-    double h = (b - a) / n;
-    double sum = 0.0;
-    for (int i = 0; i < n; ++i) 
+    return [&singular_x](double x) 
     {
-        double x = a + i * h;
         double fx = f(x);
-        if (!isfinite(fx)) 
+        if (!isfinite(fx) && isnan(singular_x)) 
         {
-            cerr << "Ошибка: особенность в узле x = " << x << " при вычислении левого правила.\n";
-            return numeric_limits<double>::quiet_NaN(); // Возвращаем NaN при проблемах
+            singular_x = x;
         }
-        sum += fx;
+        return fx;
+    };
+}
+
+// Левое правило прямоугольников
+double left_rectangles(double a, double b, int n) 
+{
+    double singular_x = numeric_limits<double>::quiet_NaN();
+    double sum = integration::rectangles(checked_f(singular_x), a, b, n);
+    if (!isnan(singular_x)) 
+    {
+        cerr << "Ошибка: особенность в узле x = " << singular_x << " при вычислении левого правила.\n";
+        return numeric_limits<double>::quiet_NaN(); // Возвращаем NaN при проблемах
     }
-    return sum * h;
+    return sum;
 }
 
 // Правило средних точек
 double midpoint_rule(double a, double b, int n) 
 {
-    double h = (b - a) / n;
-
-    double sum = 0.0;
-    for (int i = 0; i < n; ++i) 
+    double singular_x = numeric_limits<double>::quiet_NaN();
+    double sum = integration::midpoint_rule(checked_f(singular_x), a, b, n);
+    if (!isnan(singular_x)) 
     {
-
-        double x = a + (i + 0.5) * h;
-        double fx = f(x);
-        if (!isfinite(fx)) 
-        {
-            cerr << "Ошибка: особенность в узле x = " << x << " при вычислении правила средней точки.\n";
-            return numeric_limits<double>::quiet_NaN();
-        }
-        sum += fx;
+        cerr << "Ошибка: особенность в узле x = " << singular_x << " при вычислении правила средней точки.\n";
+        return numeric_limits<double>::quiet_NaN();
     }
-    return sum * h;
+    return sum;
 }
 
 // Правило трапеций
 double trapezoidal_rule(double a, double b, int m) 
 {
-    double h = (b - a) / m;
-    double fa = f(a);
-    double fb = f(b);
     // Проверяем концы интервала на особенности
-
-    if (!isfinite(fa) || !isfinite(fb)) 
+    if (!isfinite(f(a)) || !isfinite(f(b))) 
     {
         cerr << "Ошибка: особенность на границе интервала [" << a << ", " << b << "] при вычислении трапеций.\n";
         return numeric_limits<double>::quiet_NaN();
     }
-    double sum = 0.5 * (fa + fb);
-    for (int i = 1; i < m; ++i) 
+    double singular_x = numeric_limits<double>::quiet_NaN();
+    double sum = integration::trapezoid(checked_f(singular_x), a, b, m);
+    if (!isnan(singular_x)) 
     {
-        double x = a + i * h;
-        double fx = f(x);
-        if (!isfinite(fx)) 
-        {
-            cerr << "Ошибка: особенность внутри интервала в точке x = " << x << " при вычислении трапеций.\n";
-            return numeric_limits<double>::quiet_NaN();
-        }
-        sum += fx;
+        cerr << "Ошибка: особенность внутри интервала в точке x = " << singular_x << " при вычислении трапеций.\n";
+        return numeric_limits<double>::quiet_NaN();
     }
-    return sum * h;
+    return sum;
 }
 
 // Главное значение по Коши (с малым ε)
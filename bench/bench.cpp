@@ -0,0 +1,318 @@
+// Микробенчмарки правил интегрирования: make bench.
+// Для каждого правила, подынтегральной функции и n = 10, 100, ..., 1e8
+// измеряется время на одно вычисление f, число вычислений в секунду и
+// погрешность относительно точного значения. Результат сравнивается с
+// сохранённым базовым файлом (JSON), и если какой-то случай стал медленнее
+// больше чем на порог, программа завершается с кодом 1.
+//
+//   bench [--baseline файл] [--save файл] [--threshold 0.10]
+//         [--max-n 1e8] [--repetitions 5] [--cpu 0]
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#ifdef __linux__
+#include <sched.h>
+#endif
+
+#include "function.h"
+#include "gauss_kronrod.h"
+#include "integration.h"
+#include "partial_fractions.h"
+#include "rational.h"
+#include "simd.h"
+#include "vector_math.h"
+
+using namespace std;
+
+namespace {
+
+struct options {
+    string baseline;           // с чем сравнивать
+    string save;               // куда записать новые результаты
+    double threshold = 0.10;   // допустимое замедление (доля)
+    double max_n = 1e8;
+    int repetitions = 5;       // число замеров каждого случая
+    int cpu = 0;               // ядро для привязки, -1 - не привязывать
+};
+
+// Один случай: правило, функция, n и результат замера
+struct result {
+    string rule;
+    string integrand;
+    int n;
+    double ns_per_eval;        // лучшее время одного замера / число вычислений
+    double evals_per_second;
+    double error;              // |значение - точное значение|
+};
+
+// Значение, которое компилятор не может выбросить
+volatile double sink = 0.0;
+
+// Привязка к одному ядру: меньше разброс из-за миграции между ядрами
+bool pin_to_cpu(int cpu) {
+#ifdef __linux__
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    return sched_setaffinity(0, sizeof(set), &set) == 0;
+#else
+    (void)cpu;
+    return false;
+#endif
+}
+
+// Замер: прогрев, подбор числа вызовов на замер (не меньше 2 мс, чтобы
+// малые n не упирались в точность часов), затем repetitions замеров;
+// берётся лучший, он меньше всего зависит от посторонней нагрузки
+template <typename Run>
+result measure(const string& rule, const string& integrand, int n, std::int64_t evaluations,
+               double exact, int repetitions, Run run) {
+    using clock = chrono::steady_clock;
+    double value = run();
+    sink = sink + value;
+
+    auto time_calls = [&](std::int64_t calls) {
+        clock::time_point begin = clock::now();
+        for (std::int64_t i = 0; i < calls; i++) {
+            sink = sink + run();
+        }
+        return chrono::duration<double, nano>(clock::now() - begin).count();
+    };
+
+    const double min_sample = 2e6; // нс
+    std::int64_t calls = 1;
+    double elapsed = time_calls(calls);
+    while (elapsed < min_sample) {
+        calls = elapsed > 0 ? std::max<std::int64_t>(calls * 2, static_cast<std::int64_t>(
+                                  calls * min_sample / elapsed * 1.2)) : calls * 2;
+        elapsed = time_calls(calls);
+    }
+    double best = elapsed / calls;
+    for (int r = 1; r < repetitions; r++) {
+        best = std::min(best, time_calls(calls) / calls);
+    }
+
+    result out;
+    out.rule = rule;
+    out.integrand = integrand;
+    out.n = n;
+    out.ns_per_eval = best / evaluations;
+    out.evals_per_second = 1e9 / out.ns_per_eval;
+    out.error = std::abs(value - exact);
+    return out;
+}
+
+// Подынтегральная функция с отрезком и точными значениями
+template <typename Function>
+struct integrand {
+    string name;
+    Function f;
+    double a, b;
+    double exact;              // интеграл по [a, b]
+    double pv_a, pv_b;         // отрезок для cauchy_principal_value
+    double singularity;
+    double exact_pv;
+};
+
+template <typename Function>
+void run_rules(const integrand<Function>& in, const options& opt, vector<result>& results) {
+    const Function& f = in.f;
+    for (double size = 10; size <= opt.max_n; size *= 10) {
+        int n = static_cast<int>(size);
+        auto report = [&](const result& r) {
+            cout << setw(24) << left << r.rule << setw(10) << r.integrand << right
+                 << setw(11) << r.n << fixed << setprecision(3) << setw(11) << r.ns_per_eval
+                 << scientific << setprecision(3) << setw(13) << r.evals_per_second
+                 << setw(13) << r.error << "\n" << flush;
+            results.push_back(r);
+        };
+        report(measure("rectangles", in.name, n, n, in.exact, opt.repetitions,
+                       [&] { return integration::rectangles(f, in.a, in.b, n); }));
+        report(measure("midpoint_rule", in.name, n, n, in.exact, opt.repetitions,
+                       [&] { return integration::midpoint_rule(f, in.a, in.b, n); }));
+        report(measure("trapezoid", in.name, n, n + 1, in.exact, opt.repetitions,
+                       [&] { return integration::trapezoid(f, in.a, in.b, n); }));
+        report(measure("simpson", in.name, n, n + 1, in.exact, opt.repetitions,
+                       [&] { return integration::simpson(f, in.a, in.b, n); }));
+        report(measure("cauchy_principal_value", in.name, n, n, in.exact_pv, opt.repetitions, [&] {
+            return integration::cauchy_principal_value(f, in.pv_a, in.pv_b, n, in.singularity);
+        }));
+    }
+}
+
+// Базовый файл: по одному случаю на строку, как его пишет save_baseline
+void save_baseline(const string& path, const vector<result>& results) {
+    ofstream out(path);
+    if (!out) {
+        cerr << "Ошибка: не удалось записать " << path << endl;
+        return;
+    }
+    out << "{\n  \"kernels\": \"" << integration::vmath::kernel_name() << " / "
+        << integration::simd::rational_kernel_name() << "\",\n  \"results\": [\n";
+    for (size_t i = 0; i < results.size(); i++) {
+        const result& r = results[i];
+        char line[256];
+        snprintf(line, sizeof(line),
+                 "    {\"rule\": \"%s\", \"integrand\": \"%s\", \"n\": %d, "
+                 "\"ns_per_eval\": %.6g, \"error\": %.6g}%s\n",
+                 r.rule.c_str(), r.integrand.c_str(), r.n, r.ns_per_eval, r.error,
+                 i + 1 < results.size() ? "," : "");
+        out << line;
+    }
+    out << "  ]\n}\n";
+    cout << "Базовые результаты записаны в " << path << "\n";
+}
+
+// Значение поля "key" в строке JSON-объекта
+string json_field(const string& line, const string& key) {
+    size_t at = line.find("\"" + key + "\"");
+    if (at == string::npos) {
+        return "";
+    }
+    at = line.find(':', at);
+    if (at == string::npos) {
+        return "";
+    }
+    at = line.find_first_not_of(" \"", at + 1);
+    size_t end = line.find_first_of("\",}", at);
+    return at == string::npos ? "" : line.substr(at, end - at);
+}
+
+// Время на вычисление для каждого случая (rule, integrand, n) из базового файла
+map<string, double> load_baseline(const string& path) {
+    map<string, double> baseline;
+    ifstream in(path);
+    string line;
+    while (getline(in, line)) {
+        string rule = json_field(line, "rule");
+        string ns = json_field(line, "ns_per_eval");
+        if (rule.empty() || ns.empty()) {
+            continue;
+        }
+        baseline[rule + "/" + json_field(line, "integrand") + "/" + json_field(line, "n")] =
+            strtod(ns.c_str(), nullptr);
+    }
+    return baseline;
+}
+
+// Число случаев, замедлившихся больше чем на threshold
+int compare(const map<string, double>& baseline, const vector<result>& results, double threshold) {
+    int regressions = 0, compared = 0;
+    for (const result& r : results) {
+        auto it = baseline.find(r.rule + "/" + r.integrand + "/" + to_string(r.n));
+        if (it == baseline.end() || it->second <= 0) {
+            continue;
+        }
+        compared++;
+        double ratio = r.ns_per_eval / it->second;
+        if (ratio > 1.0 + threshold) {
+            regressions++;
+            cout << "ЗАМЕДЛЕНИЕ: " << r.rule << " " << r.integrand << " n = " << r.n << ": "
+                 << fixed << setprecision(3) << it->second << " -> " << r.ns_per_eval
+                 << " нс/вычисление (+" << setprecision(1) << (ratio - 1.0) * 100 << "%)\n";
+        }
+    }
+    cout << "Сравнено с базовым файлом: " << compared << " случаев, замедлений: "
+         << regressions << " (порог " << fixed << setprecision(0) << threshold * 100 << "%)\n";
+    return regressions;
+}
+
+bool parse_options(int argc, char** argv, options& opt) {
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "Ошибка: нет значения для " << arg << endl;
+            return false;
+        }
+        const char* value = argv[++i];
+        if (arg == "--baseline") {
+            opt.baseline = value;
+        } else if (arg == "--save") {
+            opt.save = value;
+        } else if (arg == "--threshold") {
+            opt.threshold = strtod(value, nullptr);
+        } else if (arg == "--max-n") {
+            opt.max_n = strtod(value, nullptr);
+        } else if (arg == "--repetitions") {
+            opt.repetitions = std::max(1, atoi(value));
+        } else if (arg == "--cpu") {
+            opt.cpu = atoi(value);
+        } else {
+            cerr << "Ошибка: неизвестный параметр " << arg << endl;
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    options opt;
+    if (!parse_options(argc, argv, opt)) {
+        return 2;
+    }
+    if (opt.cpu >= 0 && !pin_to_cpu(opt.cpu)) {
+        cerr << "Предупреждение: не удалось привязаться к ядру " << opt.cpu << endl;
+    }
+
+    const double pi = std::acos(-1.0);
+
+    // f(x) = 1/(x^2 + 4x + 3) из с/main.cpp: точные значения по первообразной
+    const integration::partial_fractions F(integration::rational({1.0}, {3.0, 4.0, 1.0}));
+    integrand<rational_function> rational{"rational", {}, 0.0, 1.0, F(1.0) - F(0.0),
+                                          -2.0, 0.0, -1.0, F.principal_value(-2.0, 0.0)};
+
+    // sin(x^2 + 2.5)/(x^3 + 3) из simple-maxim.cpp: первообразной нет, эталон -
+    // адаптивный Гаусс-Кронрод с погрешностью 1e-14; особенностей нет, поэтому
+    // главное значение совпадает с обычным интегралом
+    sine_function sine_f;
+    double sine_exact = integration::gauss_kronrod(sine_f, 0.4, 2.2, 1e-14).value;
+    integrand<sine_function> sine{"sine", sine_f, 0.4, 2.2, sine_exact,
+                                  0.4, 2.2, 1.3, sine_exact};
+
+    // 1/cos(x) из simple-nizza.cpp: [0, pi/4] и главное значение на [0, 3pi/4]
+    const secant_antiderivative G;
+    integrand<secant_function> secant{"secant", {}, 0.0, pi / 4, G(pi / 4) - G(0.0),
+                                      0.0, 3 * pi / 4, pi / 2, G(3 * pi / 4) - G(0.0)};
+
+    cout << "МИКРОБЕНЧМАРКИ ПРАВИЛ ИНТЕГРИРОВАНИЯ\n";
+    cout << "Ядра: " << integration::vmath::kernel_name() << " / "
+         << integration::simd::rational_kernel_name() << ", ядро процессора: " << opt.cpu
+         << ", замеров: " << opt.repetitions << "\n\n";
+    cout << "правило                 функция             n     нс/выч        выч/с  погрешность\n";
+    cout << string(82, '-') << "\n";
+
+    vector<result> results;
+    run_rules(rational, opt, results);
+    run_rules(sine, opt, results);
+    run_rules(secant, opt, results);
+    cout << "\n";
+
+    int regressions = 0;
+    if (!opt.baseline.empty()) {
+        map<string, double> baseline = load_baseline(opt.baseline);
+        if (baseline.empty()) {
+            cout << "Базовый файл " << opt.baseline << " не найден или пуст "
+                 << "(создать: make bench-baseline)\n";
+        } else {
+            regressions = compare(baseline, results, opt.threshold);
+        }
+    }
+    if (!opt.save.empty()) {
+        save_baseline(opt.save, results);
+    }
+    return regressions > 0 ? 1 : 0;
+}
@@ -0,0 +1,136 @@
+// Регрессионные проверки численных случаев, на которых ошибались
+// эвристики: make check. Каждая проверка печатает строку; при расхождении
+// программа завершается с кодом 1.
+
+#include <cfloat>
+#include <cmath>
+#include <complex>
+#include <cstdio>
+#include <vector>
+
+#include "oscillatory.h"
+#include "partial_fractions.h"
+#include "polynomial.h"
+#include "rational.h"
+#include "summation.h"
+#include "tanh_sinh.h"
+
+namespace {
+
+int failures = 0;
+
+void check(bool ok, const char* name) {
+    std::printf("%s: %s\n", name, ok ? "ok" : "FAILED");
+    if (!ok) {
+        failures++;
+    }
+}
+
+bool close(double x, double y, double tolerance) {
+    return std::abs(x - y) <= tolerance * std::max(1.0, std::abs(y));
+}
+
+// Близкие, но различные корни не объединяются в кратный, а корни с малой
+// мнимой частью не становятся вещественными
+void polynomial_checks() {
+    using integration::polynomial_root_clusters;
+
+    // (x - 0.5)(x - 0.500001)
+    auto close_roots = polynomial_root_clusters({0.2500005, -1.000001, 1.0});
+    check(close_roots.size() == 2 && close_roots[0].multiplicity == 1 &&
+              close(close_roots[0].value.real(), 0.5, 1e-9) &&
+              close(close_roots[1].value.real(), 0.500001, 1e-9),
+          "polynomial: корни 0.5 и 0.500001 различны");
+
+    // x^2 + 1e-12: корни +-1e-6 i
+    auto tiny_pair = polynomial_root_clusters({1e-12, 0.0, 1.0});
+    check(tiny_pair.size() == 2 && tiny_pair[0].multiplicity == 1 &&
+              close(std::abs(tiny_pair[0].value.imag()), 1e-6, 1e-9),
+          "polynomial: x^2 + 1e-12 - комплексная пара");
+
+    // Настоящие кратные корни по-прежнему объединяются
+    auto double_root = polynomial_root_clusters({0.01, -0.2, 1.0});
+    check(double_root.size() == 1 && double_root[0].multiplicity == 2 &&
+              double_root[0].value.imag() == 0.0 && close(double_root[0].value.real(), 0.1, 1e-12),
+          "polynomial: (x - 0.1)^2 - двукратный корень");
+    auto quadruple = polynomial_root_clusters({1.0, 4.0, 6.0, 4.0, 1.0});
+    check(quadruple.size() == 1 && quadruple[0].multiplicity == 4,
+          "polynomial: (x + 1)^4 - четырёхкратный корень");
+}
+
+// Точные интегралы через простейшие дроби при близких полюсах и сильно
+// различающихся вычетах
+void partial_fraction_checks() {
+    using integration::partial_fractions;
+    using integration::rational;
+
+    partial_fractions close_poles(rational({1.0}, {0.2500005, -1.000001, 1.0}));
+    check(close(close_poles.principal_value(0.0, 1.0), -4.0000000000553, 1e-9),
+          "partial_fractions: v.p. 1/((x - 0.5)(x - 0.500001)) на [0, 1]");
+
+    partial_fractions tiny_pair(rational({1.0}, {1e-12, 0.0, 1.0}));
+    check(close(tiny_pair.integral(-1.0, 1.0), 2e6 * std::atan(1e6), 1e-12),
+          "partial_fractions: 1/(x^2 + 1e-12) на [-1, 1]");
+
+    // 1e-12/(x - 1) + 1/(x - 2): малый вычет не отбрасывается
+    partial_fractions small_residue(rational({-1.0 - 2e-12, 1.0 + 1e-12}, {2.0, -3.0, 1.0}));
+    check(small_residue.terms().size() == 2, "partial_fractions: вычет 1e-12 рядом с вычетом 1");
+
+    // Устранимый разрыв (x - 1)/((x - 1)(x + 2)) даёт одно слагаемое
+    partial_fractions removable(rational({-1.0, 1.0}, {-2.0, 1.0, 1.0}));
+    check(removable.terms().size() == 1, "partial_fractions: устранимый разрыв");
+}
+
+// Интегрируемая особенность у конца не объявляется расходимостью, а 1/x -
+// объявляется
+void tanh_sinh_checks() {
+    using integration::tanh_sinh;
+
+    auto strong = tanh_sinh([](double x) { return std::pow(x, -0.99); }, 0.0, 1.0, 1e-10);
+    check(!strong.diverged && std::abs(strong.value - 100.0) <= strong.error,
+          "tanh_sinh: x^-0.99 на [0, 1] - интеграл 100 в пределах погрешности");
+    auto weak = tanh_sinh([](double x) { return std::pow(x, -0.999); }, 0.0, 1.0, 1e-10);
+    check(!weak.diverged && !weak.converged, "tanh_sinh: x^-0.999 на [0, 1] не расходится");
+    auto odd = tanh_sinh([](double x) { return x * x * x; }, -1.0, 1.0, 1e-10);
+    check(odd.converged && std::abs(odd.value) <= 1e-10, "tanh_sinh: x^3 на [-1, 1] равен 0");
+    auto pole = tanh_sinh([](double x) { return 1.0 / x; }, 0.0, 1.0, 1e-10);
+    check(pole.diverged, "tanh_sinh: 1/x на [0, 1] расходится");
+}
+
+// Переполнение промежуточной суммы не делает точную сумму зависящей от порядка
+void exact_sum_checks() {
+    auto sum = [](std::initializer_list<double> values) {
+        integration::exact_sum total;
+        for (double x : values) {
+            total.add(x);
+        }
+        return total.value();
+    };
+    check(sum({DBL_MAX, DBL_MAX, -DBL_MAX}) == DBL_MAX &&
+              sum({DBL_MAX, -DBL_MAX, DBL_MAX}) == DBL_MAX,
+          "exact_sum: M + M - M = M при любом порядке");
+    check(sum({DBL_MAX, DBL_MAX, -DBL_MAX, -DBL_MAX, 1e-300}) == 1e-300,
+          "exact_sum: M + M - M - M + 1e-300 = 1e-300");
+    check(std::isinf(sum({DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX, DBL_MAX})), "exact_sum: 5M = inf");
+}
+
+// Бесконечное значение g в узле первого отрезка не портит суммы после деления
+void levin_checks() {
+    const double bad = 0.5 + 0.5 * std::cos(4.0 * std::atan(1.0) / 32);
+    auto result = integration::levin([&](double x) { return x == bad ? INFINITY : 1.0; },
+                                     [](double x) { return 50.0 * x; }, 0.0, 1.0, 1e-10);
+    check(result.converged && close(result.cosine, std::sin(50.0) / 50.0, 1e-12) &&
+              close(result.sine, (1.0 - std::cos(50.0)) / 50.0, 1e-12),
+          "levin: inf в узле первого отрезка");
+}
+
+} // namespace
+
+int main() {
+    polynomial_checks();
+    partial_fraction_checks();
+    tanh_sinh_checks();
+    exact_sum_checks();
+    levin_checks();
+    return failures == 0 ? 0 : 1;
+}
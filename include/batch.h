@@ -0,0 +1,94 @@
+#ifndef BATCH_H
+#define BATCH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "gauss_legendre.h"
+#include "instrumentation.h"
+#include "integration.h"
+#include "parallel.h"
+#include "simd.h"
+
+// Пакетное интегрирование семейства 1/(x^2 + p x + q) по многим задачам.
+// Задачи передаются структурой массивов (p, q, a, b - отдельные массивы),
+// чтобы векторное ядро загружало параметры соседних задач одной командой.
+// Каждая дорожка вектора считает свою задачу целиком (составное правило
+// Гаусса-Лежандра), поэтому ширина SIMD используется полностью даже при
+// малом числе узлов. Внешний цикл по блокам задач выполняется политикой:
+// sequential_execution - в вызывающем потоке, parallel_execution - в пуле.
+
+namespace integration {
+
+// Задачи в виде структуры массивов; result заполняется функцией
+struct rational_batch {
+    const double* p;      // коэффициенты при x
+    const double* q;      // свободные члены
+    const double* a;      // левые концы
+    const double* b;      // правые концы
+    double* result;       // интегралы
+    std::size_t count;    // число задач
+};
+
+namespace detail {
+
+// Блоки задач [begin, end) - последовательно
+template <typename Body>
+void for_each_block(const sequential_execution&, std::size_t count, std::int64_t, Body&& body) {
+    body(std::size_t{0}, count);
+}
+
+// Блоки задач - в пуле; размер блока зависит только от объёма работы,
+// так что разбиение не меняется с числом потоков
+template <typename Body>
+void for_each_block(const parallel_execution& execution, std::size_t count,
+                    std::int64_t work_per_item, Body&& body) {
+    thread_pool& workers = execution.pool ? *execution.pool : default_pool();
+    std::int64_t items = static_cast<std::int64_t>(count);
+    if (workers.size() == 1 || items * work_per_item < 2 * execution.grain) {
+        body(std::size_t{0}, count);
+        return;
+    }
+    // Блок кратен 8 задачам, чтобы векторное ядро не уходило в скалярный хвост
+    std::int64_t block = std::max<std::int64_t>(1, execution.grain / work_per_item);
+    block = std::max(block, (items + execution.max_chunks - 1) / execution.max_chunks);
+    block = (block + 7) / 8 * 8;
+    std::int64_t blocks = (items + block - 1) / block;
+    parallel_for(workers, blocks, [&](std::int64_t c) {
+        std::size_t begin = static_cast<std::size_t>(c * block);
+        std::size_t end = std::min(count, static_cast<std::size_t>((c + 1) * block));
+        body(begin, end);
+    });
+}
+
+} // namespace detail
+
+// Интегралы всех задач пакета составным правилом Гаусса-Лежандра порядка
+// order (1..64) на parts частях каждого отрезка. При недопустимом порядке
+// результаты - NaN.
+template <typename Execution = sequential_execution>
+void integrate_batch(const rational_batch& batch, int order, int parts = 1,
+                     const Execution& execution = Execution()) {
+    INTEGRATION_RULE_SCOPE("integrate_batch");
+    gauss_legendre_view rule = gauss_legendre_rule(order);
+    if (rule.order == 0 || parts <= 0) {
+        std::fill(batch.result, batch.result + batch.count,
+                  std::numeric_limits<double>::quiet_NaN());
+        return;
+    }
+    INTEGRATION_COUNT_EVALUATIONS(static_cast<std::int64_t>(batch.count) * order * parts);
+    detail::for_each_block(execution, batch.count, static_cast<std::int64_t>(order) * parts,
+                           [&](std::size_t begin, std::size_t end) {
+                               simd::rational_batch(batch.p + begin, batch.q + begin,
+                                                    batch.a + begin, batch.b + begin,
+                                                    batch.result + begin, end - begin,
+                                                    rule.nodes, rule.weights, order, parts);
+                           });
+}
+
+} // namespace integration
+
+#endif // BATCH_H
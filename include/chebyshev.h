@@ -0,0 +1,290 @@
+#ifndef CHEBYSHEV_H
+#define CHEBYSHEV_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "instrumentation.h"
+#include "rational.h"
+
+// Кусочно-чебышёвская аппроксимация функции для многократных запросов
+// интеграла по разным подотрезкам [x0, x1] одного отрезка [a, b].
+// Построение (один раз): на каждом куске f вычисляется в точках
+// Чебышёва-Лобатто cos(pi j / n), n = 16, 32, 64, 128 (старые точки при
+// удвоении переиспользуются), коэффициенты получаются дискретным
+// косинус-преобразованием (DCT-I). Если хвост коэффициентов не опустился до
+// допуска, кусок делится пополам. Начальное разбиение идёт по полюсам
+// функции (breakpoints из rational.h); куски у полюса делятся, пока не
+// станут короче min_width_, и последний считается расходящимся.
+// Затем ряд каждого куска интегрируется почленно, и хранятся накопленные
+// интегралы до начала каждого куска. Запрос - двоичный поиск кусков и
+// вычисление двух рядов по схеме Кленшоу, то есть O(степени).
+
+namespace integration {
+
+// Ответ на запрос: значение интеграла и оценка его погрешности
+struct chebyshev_estimate {
+    double value;
+    double error;
+};
+
+class chebyshev_surrogate {
+public:
+    static constexpr int min_degree = 16;
+    static constexpr int max_degree = 128;
+
+    template <typename Function>
+    chebyshev_surrogate(Function f, double a, double b, double abs_tol = 1e-13,
+                        double rel_tol = 1e-13, int max_pieces = 1024)
+        : abs_tol_(abs_tol), rel_tol_(rel_tol), max_pieces_(max_pieces),
+          min_width_(1e-10 * std::abs(b - a)) {
+        INTEGRATION_RULE_SCOPE("chebyshev_surrogate");
+        std::vector<double> points = breakpoints(f, a, b);
+        poles_.assign(points.begin() + 1, points.end() - 1);
+        for (std::size_t i = 0; i + 1 < points.size(); i++) {
+            build(f, points[i], points[i + 1]);
+        }
+        // Накопленные интеграл и погрешность до начала каждого куска. Кусок с
+        // бесконечным интегралом (у полюса) начинает новую серию накопления,
+        // чтобы бесконечность не попала в запросы по соседним кускам
+        double value = 0.0, error = 0.0;
+        int run = 0;
+        for (piece& p : pieces_) {
+            bool finite = std::isfinite(p.total);
+            if (!finite) {
+                value = error = 0.0;
+                run++;
+            }
+            p.value_before = value;
+            p.error_before = error;
+            p.run = run;
+            value += p.total;
+            error += p.error;
+            if (!finite) {
+                value = error = 0.0;
+                run++;
+            }
+        }
+        INTEGRATION_COUNT_EVALUATIONS(evaluations_);
+    }
+
+    // Значение аппроксимации в точке x
+    double operator()(double x) const {
+        std::size_t i = locate(x);
+        if (i == pieces_.size()) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        const piece& p = pieces_[i];
+        return clenshaw(&values_[p.offset], p.degree, position(p, x));
+    }
+
+    // Интеграл по [x0, x1] внутри отрезка построения
+    chebyshev_estimate integral(double x0, double x1) const {
+        if (x1 < x0) {
+            chebyshev_estimate reversed = integral(x1, x0);
+            return {-reversed.value, reversed.error};
+        }
+        std::size_t first = locate(x0), last = locate(x1);
+        if (first == pieces_.size() || last == pieces_.size()) {
+            double nan = std::numeric_limits<double>::quiet_NaN();
+            return {nan, nan};
+        }
+        const piece& p = pieces_[first];
+        const piece& q = pieces_[last];
+        if (p.run != q.run) {
+            // Между концами лежит кусок с бесконечным интегралом
+            return {std::numeric_limits<double>::quiet_NaN(),
+                    std::numeric_limits<double>::infinity()};
+        }
+        double error = q.error_before + q.error - p.error_before;
+        return {cumulative(last, x1) - cumulative(first, x0), error};
+    }
+
+    bool converged() const { return converged_; }
+    int pieces() const { return static_cast<int>(pieces_.size()); }
+    std::int64_t evaluations() const { return evaluations_; }
+
+private:
+    // Кусок [a, b]: коэффициенты f (values_) и её первообразной (integrals_)
+    struct piece {
+        double a, b;
+        std::size_t offset;        // начало коэффициентов в values_
+        std::size_t integral;      // начало коэффициентов в integrals_
+        int degree;                // степень ряда f; у первообразной на 1 больше
+        double total;              // интеграл по всему куску
+        double error;              // оценка погрешности интеграла по куску
+        double value_before;       // интеграл от начала отрезка до a
+        double error_before;
+        int run;                   // номер серии накопления
+    };
+
+    // Коэффициенты c_0..c_n по значениям в точках cos(pi j / n) (DCT-I)
+    static std::vector<double> coefficients(const std::vector<double>& samples) {
+        const int n = static_cast<int>(samples.size()) - 1;
+        const double pi = 4.0 * std::atan(1.0);
+        std::vector<double> cosines(2 * n);
+        for (int j = 0; j < 2 * n; j++) {
+            cosines[j] = std::cos(pi * j / n);
+        }
+        std::vector<double> result(n + 1);
+        for (int k = 0; k <= n; k++) {
+            double sum = 0.5 * (samples[0] + ((k % 2 == 0) ? samples[n] : -samples[n]));
+            for (int j = 1; j < n; j++) {
+                sum += samples[j] * cosines[(j * k) % (2 * n)];
+            }
+            result[k] = sum * 2.0 / n;
+        }
+        result[0] *= 0.5;
+        result[n] *= 0.5;
+        return result;
+    }
+
+    // Сумма sum c_k T_k(t) по схеме Кленшоу
+    static double clenshaw(const double* c, int degree, double t) {
+        double b1 = 0.0, b2 = 0.0;
+        for (int k = degree; k > 0; k--) {
+            double b0 = 2.0 * t * b1 - b2 + c[k];
+            b2 = b1;
+            b1 = b0;
+        }
+        return t * b1 - b2 + c[0];
+    }
+
+    template <typename Function>
+    void build(Function& f, double a, double b) {
+        const double pi = 4.0 * std::atan(1.0);
+        const double center = 0.5 * (a + b);
+        const double half = 0.5 * (b - a);
+
+        // Значения в точках Лобатто; при удвоении n старые точки - чётные
+        std::vector<double> samples(min_degree + 1);
+        for (int j = 0; j <= min_degree; j++) {
+            samples[j] = f(center + half * std::cos(pi * j / min_degree));
+        }
+        evaluations_ += min_degree + 1;
+
+        std::vector<double> c;
+        double tolerance = 0.0;
+        double scale = 0.0;
+        double tail = 0.0, previous_tail = std::numeric_limits<double>::infinity();
+        bool finite = true;
+        bool fitted = false;
+        for (int n = min_degree;; n *= 2) {
+            c = coefficients(samples);
+            scale = 0.0;
+            finite = true;
+            for (double value : samples) {
+                finite = finite && std::isfinite(value);
+                scale = std::max(scale, std::abs(value));
+            }
+            tolerance = std::max(abs_tol_, rel_tol_ * scale);
+            previous_tail = tail;
+            tail = std::max({std::abs(c[n]), std::abs(c[n - 1]), std::abs(c[n - 2])});
+            if (finite && tail <= tolerance) {
+                fitted = true;
+                break;
+            }
+            if (!finite || n == max_degree) {
+                break;
+            }
+            std::vector<double> refined(2 * n + 1);
+            for (int j = 0; j <= 2 * n; j++) {
+                refined[j] = (j % 2 == 0) ? samples[j / 2]
+                                          : f(center + half * std::cos(pi * j / (2 * n)));
+            }
+            evaluations_ += n;
+            samples.swap(refined);
+        }
+
+        const double epsilon = std::numeric_limits<double>::epsilon();
+        bool can_split = static_cast<int>(pieces_.size()) + 2 <= max_pieces_ &&
+                         b - a > min_width_ && a < center && center < b;
+        // Хвост на уровне округления: точнее по значениям f не получить
+        bool rounding = finite && !fitted && tail <= 100.0 * epsilon * scale;
+        // Хвост мал и перестал убывать при удвоении степени - это шум
+        // вычисления самой f (сокращение разрядов у полюса), деление его не
+        // уменьшит. Кусок не делится, но допуск на нём не достигнут
+        bool noise = finite && !fitted && tail <= std::sqrt(epsilon) * scale &&
+                     tail > 0.25 * previous_tail;
+        if (!fitted && !rounding && !noise && can_split) {
+            build(f, a, center);
+            build(f, center, b);
+            return;
+        }
+        // Неприближаемый кусок у полюса: интеграл по нему расходится
+        bool at_pole = std::binary_search(poles_.begin(), poles_.end(), a) ||
+                       std::binary_search(poles_.begin(), poles_.end(), b);
+        bool diverges = !fitted && !rounding && !noise && at_pole;
+        converged_ = converged_ && (fitted || rounding || diverges);
+
+        // Отбрасываем хвост ниже допуска; его сумма (и оценка следующих
+        // коэффициентов tail) входит в оценку погрешности
+        int degree = static_cast<int>(c.size()) - 1;
+        double dropped = std::abs(c[degree]);
+        while (degree > 0 && dropped + std::abs(c[degree - 1]) <= tolerance) {
+            degree--;
+            dropped += std::abs(c[degree]);
+        }
+        double error = finite && !diverges
+                           ? 2.0 * std::abs(half) * (dropped + tail + degree * epsilon * scale)
+                           : std::numeric_limits<double>::infinity();
+
+        // Первообразная на [-1, 1] с нулём в t = -1:
+        //   b_k = (c_{k-1} - c_{k+1}) / (2k), к c_0 ряд f без множителя 1/2
+        piece p{a, b, values_.size(), integrals_.size(), degree, 0.0, error, 0.0, 0.0, 0};
+        values_.insert(values_.end(), c.begin(), c.begin() + degree + 1);
+        std::vector<double> primitive(degree + 2, 0.0);
+        for (int k = 1; k <= degree + 1; k++) {
+            double previous = (k == 1) ? 2.0 * c[0] : c[k - 1];
+            double next = (k + 1 <= degree) ? c[k + 1] : 0.0;
+            primitive[k] = half * (previous - next) / (2.0 * k);
+        }
+        for (int k = 1; k <= degree + 1; k++) {
+            primitive[0] -= (k % 2 == 0) ? primitive[k] : -primitive[k];
+        }
+        p.total = diverges ? std::numeric_limits<double>::infinity()
+                           : clenshaw(primitive.data(), degree + 1, 1.0);
+        integrals_.insert(integrals_.end(), primitive.begin(), primitive.end());
+        pieces_.push_back(p);
+    }
+
+    // Номер куска, содержащего x (pieces_.size(), если x вне отрезка)
+    std::size_t locate(double x) const {
+        if (pieces_.empty() || !(x >= pieces_.front().a && x <= pieces_.back().b)) {
+            return pieces_.size();
+        }
+        auto it = std::upper_bound(pieces_.begin(), pieces_.end(), x,
+                                   [](double value, const piece& p) { return value < p.b; });
+        return it == pieces_.end() ? pieces_.size() - 1 : static_cast<std::size_t>(it - pieces_.begin());
+    }
+
+    static double position(const piece& p, double x) {
+        return std::clamp((2.0 * x - p.a - p.b) / (p.b - p.a), -1.0, 1.0);
+    }
+
+    // Интеграл от начала отрезка до x внутри куска i
+    double cumulative(std::size_t i, double x) const {
+        const piece& p = pieces_[i];
+        return p.value_before + clenshaw(&integrals_[p.integral], p.degree + 1, position(p, x));
+    }
+
+    double abs_tol_;
+    double rel_tol_;
+    int max_pieces_;
+    double min_width_;
+    bool converged_ = true;
+    std::int64_t evaluations_ = 0;
+    std::vector<double> poles_;     // полюса внутри отрезка по возрастанию
+    std::vector<piece> pieces_;
+    std::vector<double> values_;
+    std::vector<double> integrals_;
+};
+
+} // namespace integration
+
+#endif // CHEBYSHEV_H
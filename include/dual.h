@@ -0,0 +1,149 @@
+#ifndef DUAL_H
+#define DUAL_H
+
+#include <array>
+#include <cmath>
+
+#include "summation.h"
+
+// Дуальные числа для прямого автоматического дифференцирования:
+// значение и градиент по N параметрам переносятся через все операции
+// одновременно. Правила интегрирования (integration.h, gauss_legendre.h)
+// складывают значения того типа, который возвращает f, поэтому если
+// подынтегральная функция зависит от параметров-дуальных чисел, один проход
+// квадратуры даёт и интеграл, и его производные по всем параметрам -
+// вместо 2N + 1 интегрирований для центральных разностей:
+//   integration::dual<2> p = dual<2>::variable(4.0, 0), q = dual<2>::variable(3.0, 1);
+//   auto I = integration::simpson([&](double x) { return 1.0 / (x * x + p * x + q); }, 0, 1, 100);
+//   I.value - интеграл, I.gradient[0] = dI/dp, I.gradient[1] = dI/dq
+// Производная квадратурной суммы совпадает с квадратурой производной
+// подынтегральной функции, то есть имеет тот же порядок точности.
+
+namespace integration {
+
+template <int N>
+struct dual {
+    double value = 0.0;
+    std::array<double, N> gradient{};
+
+    dual() = default;
+    dual(double v) : value(v) {} // константа: нулевой градиент
+
+    // Параметр номер index со значением v
+    static dual variable(double v, int index) {
+        dual result(v);
+        result.gradient[index] = 1.0;
+        return result;
+    }
+
+    dual& operator+=(const dual& other) {
+        value += other.value;
+        for (int i = 0; i < N; i++) gradient[i] += other.gradient[i];
+        return *this;
+    }
+    dual& operator-=(const dual& other) {
+        value -= other.value;
+        for (int i = 0; i < N; i++) gradient[i] -= other.gradient[i];
+        return *this;
+    }
+    dual& operator*=(const dual& other) {
+        for (int i = 0; i < N; i++) gradient[i] = gradient[i] * other.value + value * other.gradient[i];
+        value *= other.value;
+        return *this;
+    }
+    dual& operator/=(const dual& other) {
+        double inverse = 1.0 / other.value;
+        value *= inverse;
+        for (int i = 0; i < N; i++) gradient[i] = (gradient[i] - value * other.gradient[i]) * inverse;
+        return *this;
+    }
+};
+
+template <int N> dual<N> operator+(dual<N> x, const dual<N>& y) { return x += y; }
+template <int N> dual<N> operator-(dual<N> x, const dual<N>& y) { return x -= y; }
+template <int N> dual<N> operator*(dual<N> x, const dual<N>& y) { return x *= y; }
+template <int N> dual<N> operator/(dual<N> x, const dual<N>& y) { return x /= y; }
+
+// Смешанные операции с double (без градиента) - без лишних умножений на ноль
+template <int N> dual<N> operator+(dual<N> x, double y) { x.value += y; return x; }
+template <int N> dual<N> operator+(double x, dual<N> y) { y.value += x; return y; }
+template <int N> dual<N> operator-(dual<N> x, double y) { x.value -= y; return x; }
+template <int N> dual<N> operator-(double x, const dual<N>& y) { return x + (-y); }
+template <int N> dual<N> operator*(dual<N> x, double y) {
+    x.value *= y;
+    for (double& g : x.gradient) g *= y;
+    return x;
+}
+template <int N> dual<N> operator*(double x, dual<N> y) { return y * x; }
+template <int N> dual<N> operator/(dual<N> x, double y) { return x * (1.0 / y); }
+template <int N> dual<N> operator/(double x, const dual<N>& y) {
+    // d(x / y) = -x / y^2 dy
+    double value = x / y.value;
+    dual<N> result(value);
+    for (int i = 0; i < N; i++) result.gradient[i] = -value / y.value * y.gradient[i];
+    return result;
+}
+
+template <int N> dual<N> operator-(dual<N> x) { return x * -1.0; }
+
+template <int N> bool operator<(const dual<N>& x, const dual<N>& y) { return x.value < y.value; }
+template <int N> bool operator>(const dual<N>& x, const dual<N>& y) { return x.value > y.value; }
+
+// Элементарные функции: f(x) и f'(x) dx
+template <int N> dual<N> chain(const dual<N>& x, double value, double derivative) {
+    dual<N> result(value);
+    for (int i = 0; i < N; i++) result.gradient[i] = derivative * x.gradient[i];
+    return result;
+}
+
+template <int N> dual<N> sin(const dual<N>& x) { return chain(x, std::sin(x.value), std::cos(x.value)); }
+template <int N> dual<N> cos(const dual<N>& x) { return chain(x, std::cos(x.value), -std::sin(x.value)); }
+template <int N> dual<N> tan(const dual<N>& x) {
+    double t = std::tan(x.value);
+    return chain(x, t, 1.0 + t * t);
+}
+template <int N> dual<N> exp(const dual<N>& x) {
+    double e = std::exp(x.value);
+    return chain(x, e, e);
+}
+template <int N> dual<N> log(const dual<N>& x) { return chain(x, std::log(x.value), 1.0 / x.value); }
+template <int N> dual<N> sqrt(const dual<N>& x) {
+    double r = std::sqrt(x.value);
+    return chain(x, r, 0.5 / r);
+}
+template <int N> dual<N> abs(const dual<N>& x) { return x.value < 0 ? -x : x; }
+template <int N> dual<N> pow(const dual<N>& x, double p) {
+    return chain(x, std::pow(x.value, p), p * std::pow(x.value, p - 1.0));
+}
+template <int N> dual<N> pow(const dual<N>& x, const dual<N>& p) { return exp(p * log(x)); }
+
+template <int N> bool isfinite(const dual<N>& x) { return std::isfinite(x.value); }
+template <int N> bool isnan(const dual<N>& x) { return std::isnan(x.value); }
+
+// Точная сумма дуальных чисел: отдельная exact_sum для значения и для
+// каждой компоненты градиента (воспроизводимый режим суммирования)
+template <int N>
+class exact_accumulator<dual<N>> {
+public:
+    void add(const dual<N>& x) {
+        value_.add(x.value);
+        for (int i = 0; i < N; i++) gradient_[i].add(x.gradient[i]);
+    }
+    void add(const exact_accumulator& other) {
+        value_.add(other.value_);
+        for (int i = 0; i < N; i++) gradient_[i].add(other.gradient_[i]);
+    }
+    dual<N> value() const {
+        dual<N> result(value_.value());
+        for (int i = 0; i < N; i++) result.gradient[i] = gradient_[i].value();
+        return result;
+    }
+
+private:
+    exact_sum value_;
+    std::array<exact_sum, N> gradient_;
+};
+
+} // namespace integration
+
+#endif // DUAL_H
@@ -0,0 +1,578 @@
+#ifndef EXPRESSION_H
+#define EXPRESSION_H
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <string>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "vector_math.h"
+
+// Подынтегральная функция, заданная строкой во время выполнения:
+//   integration::expression f("sin(x^2 + 2.5) / (x^3 + 3)");
+//   integration::trapezoid(f, a, b, n);
+// Выражение разбирается рекурсивным спуском и сразу строится граф без
+// повторов: одинаковые подвыражения становятся одним узлом (устранение общих
+// подвыражений), операции над константами вычисляются при компиляции, а
+// целые степени заменяются умножениями. Граф переводится в байт-код для
+// регистровой машины; каждый регистр хранит блок из 64 значений, и каждая
+// команда выполняется сразу для всего блока, так что разбор команды
+// окупается 64 раза, а простые циклы по блоку векторизуются компилятором.
+// (При блоке 16 выбор команды занимал около половины времени на дробно-
+// рациональных функциях.) sin, cos, exp, log, sqrt и pow над блоком
+// вычисляются векторной библиотекой vector_math.h; одиночный вызов f(x)
+// использует <cmath>, и результаты могут отличаться в последнем бите.
+// Регистры переиспользуются после последнего чтения.
+// Поддерживаются: числа, x, pi, e, + - * / ^, унарный минус, скобки,
+// sin cos tan exp log sqrt abs и pow(a, b).
+
+namespace integration {
+
+namespace detail {
+
+enum class opcode : unsigned char {
+    add, sub, mul, div, neg, pow, sin, cos, tan, exp, log, sqrt, abs
+};
+
+// Команда dst = op(a, b); у унарных операций b = a и не читается
+struct instruction {
+    opcode op;
+    int dst, a, b;
+};
+
+inline double apply(opcode op, double a, double b) {
+    switch (op) {
+    case opcode::add: return a + b;
+    case opcode::sub: return a - b;
+    case opcode::mul: return a * b;
+    case opcode::div: return a / b;
+    case opcode::neg: return -a;
+    case opcode::pow: return std::pow(a, b);
+    case opcode::sin: return std::sin(a);
+    case opcode::cos: return std::cos(a);
+    case opcode::tan: return std::tan(a);
+    case opcode::exp: return std::exp(a);
+    case opcode::log: return std::log(a);
+    case opcode::sqrt: return std::sqrt(a);
+    case opcode::abs: return std::abs(a);
+    }
+    return std::numeric_limits<double>::quiet_NaN();
+}
+
+} // namespace detail
+
+class expression {
+public:
+    static constexpr int block = 64;
+    // Наибольшая вложенность скобок, вызовов, унарных знаков и степеней:
+    // разбор рекурсивный, и глубже него стек не рассчитан
+    static constexpr int max_depth = 256;
+
+    explicit expression(const std::string& text) : text_(text) {
+        position_ = 0;
+        int root = parse_sum();
+        skip_spaces();
+        if (error_.empty() && position_ < text_.size()) {
+            fail("лишние символы");
+        }
+        if (error_.empty()) {
+            generate(root);
+        } else {
+            // Некорректное выражение: программа из одной константы NaN
+            registers_ = 2;
+            constants_ = {{1, std::numeric_limits<double>::quiet_NaN()}};
+            result_ = 1;
+        }
+        nodes_.clear();
+        cse_.clear();
+    }
+
+    bool valid() const { return error_.empty(); }
+    const std::string& error() const { return error_; }
+    const std::string& text() const { return text_; }
+
+    // Размер программы (для диагностики)
+    std::size_t instructions() const { return code_.size(); }
+    int registers() const { return registers_; }
+
+    double operator()(double x) const {
+        constexpr int stack_registers = 64;
+        if (registers_ <= stack_registers) {
+            double scratch[stack_registers];
+            fill_constants<1>(scratch);
+            scratch[0] = x;
+            return *run<1>(scratch);
+        }
+        std::vector<double> scratch = prepare<1>();
+        scratch[0] = x;
+        return *run<1>(scratch.data());
+    }
+
+    // y[i] = f(x[i]) для i < count, блоками по block значений
+    void evaluate(const double* x, double* y, std::size_t count) const {
+        std::vector<double> scratch = prepare<block>();
+        double* input = scratch.data();
+        for (std::size_t i = 0; i < count; i += block) {
+            std::size_t lanes = std::min<std::size_t>(block, count - i);
+            std::copy(x + i, x + i + lanes, input);
+            const double* output = run<block>(scratch.data());
+            std::copy(output, output + lanes, y + i);
+        }
+    }
+
+    // Пакетная сумма для правил из integration.h: узлы start + (i + offset) * step
+    double sum_nodes(double start, double step, double offset,
+                     int first, int last, int stride) const {
+        std::vector<double> scratch = prepare<block>();
+        double* input = scratch.data();
+        double partial[block] = {};
+        int i = first;
+        while (i < last) {
+            int lanes = 0;
+            if (stride == 1 && last - i >= block) {
+                for (; lanes < block; lanes++) {
+                    input[lanes] = start + (i + lanes + offset) * step;
+                }
+                i += block;
+            }
+            for (; lanes < block && i < last; lanes++, i += stride) {
+                input[lanes] = start + (i + offset) * step;
+            }
+            const double* output = run<block>(scratch.data());
+            for (int k = 0; k < lanes; k++) {
+                partial[k] += output[k];
+            }
+        }
+        double total = 0.0;
+        for (double value : partial) {
+            total += value;
+        }
+        return total;
+    }
+
+private:
+    // Узел графа: константа, x или операция над узлами a, b
+    struct node {
+        enum kind_type { constant, variable, operation } kind;
+        detail::opcode op;
+        int a, b;
+        double value;
+    };
+
+    // ---------- разбор ----------
+
+    void fail(const std::string& message) {
+        if (error_.empty()) {
+            error_ = "Ошибка в выражении (позиция " + std::to_string(position_ + 1) + "): " + message;
+        }
+    }
+
+    void skip_spaces() {
+        while (position_ < text_.size() && std::isspace(static_cast<unsigned char>(text_[position_]))) {
+            position_++;
+        }
+    }
+
+    bool accept(char c) {
+        skip_spaces();
+        if (position_ < text_.size() && text_[position_] == c) {
+            position_++;
+            return true;
+        }
+        return false;
+    }
+
+    int parse_sum() {
+        int left = parse_product();
+        for (;;) {
+            if (accept('+')) {
+                left = make(detail::opcode::add, left, parse_product());
+            } else if (accept('-')) {
+                left = make(detail::opcode::sub, left, parse_product());
+            } else {
+                return left;
+            }
+        }
+    }
+
+    int parse_product() {
+        int left = parse_unary();
+        for (;;) {
+            if (accept('*')) {
+                left = make(detail::opcode::mul, left, parse_unary());
+            } else if (accept('/')) {
+                left = make(detail::opcode::div, left, parse_unary());
+            } else {
+                return left;
+            }
+        }
+    }
+
+    // Через parse_unary проходит любая рекурсия разбора, поэтому глубина
+    // считается здесь
+    int parse_unary() {
+        if (depth_ >= max_depth) {
+            fail("слишком глубокая вложенность (больше " + std::to_string(max_depth) + ")");
+            return constant(std::numeric_limits<double>::quiet_NaN());
+        }
+        depth_++;
+        int result;
+        if (accept('-')) {
+            result = make(detail::opcode::neg, parse_unary());
+        } else if (accept('+')) {
+            result = parse_unary();
+        } else {
+            result = parse_power();
+        }
+        depth_--;
+        return result;
+    }
+
+    // Степень правоассоциативна и связывает сильнее унарного минуса: -x^2 = -(x^2)
+    int parse_power() {
+        int base = parse_primary();
+        if (accept('^')) {
+            return make_power(base, parse_unary());
+        }
+        return base;
+    }
+
+    int parse_primary() {
+        skip_spaces();
+        if (!error_.empty() || position_ >= text_.size()) {
+            fail("неожиданный конец выражения");
+            return constant(std::numeric_limits<double>::quiet_NaN());
+        }
+        char c = text_[position_];
+        if (std::isdigit(static_cast<unsigned char>(c)) || c == '.') {
+            const char* begin = text_.c_str() + position_;
+            char* end = nullptr;
+            double value = std::strtod(begin, &end);
+            if (end == begin) {
+                fail("неверное число");
+            }
+            position_ += static_cast<std::size_t>(end - begin);
+            return constant(value);
+        }
+        if (accept('(')) {
+            int inner = parse_sum();
+            if (!accept(')')) {
+                fail("ожидается ')'");
+            }
+            return inner;
+        }
+        if (std::isalpha(static_cast<unsigned char>(c))) {
+            std::size_t begin = position_;
+            while (position_ < text_.size() && std::isalnum(static_cast<unsigned char>(text_[position_]))) {
+                position_++;
+            }
+            std::string name = text_.substr(begin, position_ - begin);
+            if (name == "x") {
+                return variable();
+            }
+            if (name == "pi") {
+                return constant(4.0 * std::atan(1.0));
+            }
+            if (name == "e") {
+                return constant(std::exp(1.0));
+            }
+            return parse_call(name);
+        }
+        fail(std::string("неожиданный символ '") + c + "'");
+        return constant(std::numeric_limits<double>::quiet_NaN());
+    }
+
+    int parse_call(const std::string& name) {
+        static const std::map<std::string, detail::opcode> functions = {
+            {"sin", detail::opcode::sin},   {"cos", detail::opcode::cos},
+            {"tan", detail::opcode::tan},   {"exp", detail::opcode::exp},
+            {"log", detail::opcode::log},   {"sqrt", detail::opcode::sqrt},
+            {"abs", detail::opcode::abs},   {"pow", detail::opcode::pow}};
+        auto it = functions.find(name);
+        if (it == functions.end()) {
+            fail("неизвестное имя '" + name + "'");
+            return constant(std::numeric_limits<double>::quiet_NaN());
+        }
+        if (!accept('(')) {
+            fail("ожидается '(' после " + name);
+        }
+        int argument = parse_sum();
+        int result;
+        if (it->second == detail::opcode::pow) {
+            if (!accept(',')) {
+                fail("pow принимает два аргумента");
+            }
+            result = make_power(argument, parse_sum());
+        } else {
+            result = make(it->second, argument);
+        }
+        if (!accept(')')) {
+            fail("ожидается ')'");
+        }
+        return result;
+    }
+
+    // ---------- построение графа ----------
+
+    // Константы сравниваются по битам: NaN равен себе, а -0.0 отличается от 0.0
+    int add_node(const node& n) {
+        std::uint64_t bits = 0;
+        if (n.kind == node::constant) {
+            std::memcpy(&bits, &n.value, sizeof(bits));
+        }
+        auto key = std::make_tuple(static_cast<int>(n.kind), static_cast<int>(n.op), n.a, n.b, bits);
+        auto it = cse_.find(key);
+        if (it != cse_.end()) {
+            return it->second;
+        }
+        nodes_.push_back(n);
+        int index = static_cast<int>(nodes_.size()) - 1;
+        cse_.emplace(key, index);
+        return index;
+    }
+
+    int constant(double value) { return add_node({node::constant, detail::opcode::add, -1, -1, value}); }
+    int variable() { return add_node({node::variable, detail::opcode::add, -1, -1, 0.0}); }
+
+    bool is_constant(int index, double value) const {
+        return nodes_[index].kind == node::constant && nodes_[index].value == value;
+    }
+
+    // Операция со свёрткой констант и простейшими упрощениями
+    int make(detail::opcode op, int a, int b = -1) {
+        using detail::opcode;
+        bool unary = b < 0;
+        if (nodes_[a].kind == node::constant && (unary || nodes_[b].kind == node::constant)) {
+            return constant(detail::apply(op, nodes_[a].value, unary ? 0.0 : nodes_[b].value));
+        }
+        switch (op) {
+        case opcode::add:
+            if (is_constant(a, 0.0)) return b;
+            if (is_constant(b, 0.0)) return a;
+            break;
+        case opcode::sub:
+            if (is_constant(b, 0.0)) return a;
+            break;
+        case opcode::mul:
+            if (is_constant(a, 1.0)) return b;
+            if (is_constant(b, 1.0)) return a;
+            break;
+        case opcode::div:
+            if (is_constant(b, 1.0)) return a;
+            break;
+        case opcode::neg:
+            if (nodes_[a].kind == node::operation && nodes_[a].op == opcode::neg) return nodes_[a].a;
+            break;
+        default:
+            break;
+        }
+        // Для коммутативных операций порядок операндов не важен
+        if ((op == opcode::add || op == opcode::mul) && a > b) {
+            std::swap(a, b);
+        }
+        return add_node({node::operation, op, a, b, 0.0});
+    }
+
+    // base^exponent: целые степени до 64 - умножениями (возведение в квадрат),
+    // 0.5 - корень, остальные - pow
+    int make_power(int base, int exponent) {
+        using detail::opcode;
+        if (nodes_[exponent].kind == node::constant) {
+            double value = nodes_[exponent].value;
+            if (value == 0.5) {
+                return make(opcode::sqrt, base);
+            }
+            if (value == std::floor(value) && std::abs(value) <= 64.0 &&
+                nodes_[base].kind != node::constant) {
+                long power = static_cast<long>(std::abs(value));
+                int result = constant(1.0);
+                int square = base;
+                while (power > 0) {
+                    if (power & 1) {
+                        result = make(opcode::mul, result, square);
+                    }
+                    power >>= 1;
+                    if (power > 0) {
+                        square = make(opcode::mul, square, square);
+                    }
+                }
+                return value < 0 ? make(opcode::div, constant(1.0), result) : result;
+            }
+        }
+        return make(opcode::pow, base, exponent);
+    }
+
+    // ---------- генерация кода ----------
+
+    void generate(int root) {
+        // Достижимые из корня узлы (индексы детей всегда меньше индекса узла)
+        std::vector<bool> live(nodes_.size(), false);
+        live[root] = true;
+        for (int i = root; i >= 0; i--) {
+            if (live[i] && nodes_[i].kind == node::operation) {
+                live[nodes_[i].a] = true;
+                if (nodes_[i].b >= 0) {
+                    live[nodes_[i].b] = true;
+                }
+            }
+        }
+        // Последнее чтение каждого узла
+        std::vector<int> last_use(nodes_.size(), -1);
+        for (int i = 0; i <= root; i++) {
+            if (live[i] && nodes_[i].kind == node::operation) {
+                last_use[nodes_[i].a] = i;
+                if (nodes_[i].b >= 0) {
+                    last_use[nodes_[i].b] = i;
+                }
+            }
+        }
+
+        // Регистр 0 - x, затем константы (заполняются один раз), затем временные
+        std::vector<int> location(nodes_.size(), -1);
+        registers_ = 1;
+        for (int i = 0; i <= root; i++) {
+            if (!live[i]) {
+                continue;
+            }
+            if (nodes_[i].kind == node::variable) {
+                location[i] = 0;
+            } else if (nodes_[i].kind == node::constant) {
+                location[i] = registers_++;
+                constants_.push_back({location[i], nodes_[i].value});
+            }
+        }
+        std::vector<int> free_registers;
+        for (int i = 0; i <= root; i++) {
+            if (!live[i] || nodes_[i].kind != node::operation) {
+                continue;
+            }
+            const node& n = nodes_[i];
+            int a = location[n.a];
+            int b = n.b >= 0 ? location[n.b] : a;
+            int dst;
+            if (!free_registers.empty()) {
+                dst = free_registers.back();
+                free_registers.pop_back();
+            } else {
+                dst = registers_++;
+            }
+            // Регистры операндов, прочитанных в последний раз, освобождаются
+            // после выбора dst, чтобы результат не писался поверх операнда
+            for (int operand : {n.a, n.b}) {
+                if (operand >= 0 && last_use[operand] == i && nodes_[operand].kind == node::operation &&
+                    std::find(free_registers.begin(), free_registers.end(), location[operand]) ==
+                        free_registers.end()) {
+                    free_registers.push_back(location[operand]);
+                }
+            }
+            location[i] = dst;
+            code_.push_back({n.op, dst, a, b});
+        }
+        result_ = location[root];
+    }
+
+    // ---------- выполнение ----------
+
+    // d = op(a, b) по всем дорожкам. Регистр результата никогда не совпадает
+    // с операндами (см. generate), поэтому циклы векторизуются без проверок
+    // перекрытия
+    template <int Lanes, typename Operation>
+    static void lanes(double* __restrict d, const double* __restrict a,
+                      const double* __restrict b, Operation operation) {
+        for (int k = 0; k < Lanes; k++) {
+            d[k] = operation(a[k], b[k]);
+        }
+    }
+
+    // Трансцендентные функции над целым блоком - векторной библиотекой
+    // (vector_math.h); false, если для операции её нет
+    static bool vector_function(detail::opcode op, double* d, const double* a, const double* b,
+                                std::size_t count) {
+        using detail::opcode;
+        switch (op) {
+        case opcode::pow: vmath::pow(a, b, d, count); return true;
+        case opcode::sin: vmath::sin(a, d, count); return true;
+        case opcode::cos: vmath::cos(a, d, count); return true;
+        case opcode::exp: vmath::exp(a, d, count); return true;
+        case opcode::log: vmath::log(a, d, count); return true;
+        case opcode::sqrt: vmath::sqrt(a, d, count); return true;
+        default: return false;
+        }
+    }
+
+    // Регистры для Lanes значений с заполненными константами
+    template <int Lanes>
+    std::vector<double> prepare() const {
+        std::vector<double> scratch(static_cast<std::size_t>(registers_) * Lanes);
+        fill_constants<Lanes>(scratch.data());
+        return scratch;
+    }
+
+    template <int Lanes>
+    void fill_constants(double* scratch) const {
+        for (const auto& c : constants_) {
+            std::fill(scratch + c.first * Lanes, scratch + (c.first + 1) * Lanes, c.second);
+        }
+    }
+
+    // Выполнить программу для Lanes значений x из регистра 0; возвращает
+    // регистр результата. Константы в регистрах не перезаписываются, поэтому
+    // заполняются один раз на весь вызов.
+    template <int Lanes>
+    const double* run(double* scratch) const {
+        using detail::opcode;
+        for (const detail::instruction& ins : code_) {
+            double* d = scratch + ins.dst * Lanes;
+            const double* a = scratch + ins.a * Lanes;
+            const double* b = scratch + ins.b * Lanes;
+            if constexpr (Lanes > 1) {
+                if (vector_function(ins.op, d, a, b, Lanes)) {
+                    continue;
+                }
+            }
+            switch (ins.op) {
+            case opcode::add: lanes<Lanes>(d, a, b, [](double u, double v) { return u + v; }); break;
+            case opcode::sub: lanes<Lanes>(d, a, b, [](double u, double v) { return u - v; }); break;
+            case opcode::mul: lanes<Lanes>(d, a, b, [](double u, double v) { return u * v; }); break;
+            case opcode::div: lanes<Lanes>(d, a, b, [](double u, double v) { return u / v; }); break;
+            case opcode::neg: lanes<Lanes>(d, a, b, [](double u, double) { return -u; }); break;
+            case opcode::pow: lanes<Lanes>(d, a, b, [](double u, double v) { return std::pow(u, v); }); break;
+            case opcode::sin: lanes<Lanes>(d, a, b, [](double u, double) { return std::sin(u); }); break;
+            case opcode::cos: lanes<Lanes>(d, a, b, [](double u, double) { return std::cos(u); }); break;
+            case opcode::tan: lanes<Lanes>(d, a, b, [](double u, double) { return std::tan(u); }); break;
+            case opcode::exp: lanes<Lanes>(d, a, b, [](double u, double) { return std::exp(u); }); break;
+            case opcode::log: lanes<Lanes>(d, a, b, [](double u, double) { return std::log(u); }); break;
+            case opcode::sqrt: lanes<Lanes>(d, a, b, [](double u, double) { return std::sqrt(u); }); break;
+            case opcode::abs: lanes<Lanes>(d, a, b, [](double u, double) { return std::abs(u); }); break;
+            }
+        }
+        return scratch + result_ * Lanes;
+    }
+
+    std::string text_;
+    std::string error_;
+    std::size_t position_ = 0;
+    int depth_ = 0;
+
+    // Граф нужен только при компиляции
+    std::vector<node> nodes_;
+    std::map<std::tuple<int, int, int, int, std::uint64_t>, int> cse_;
+
+    std::vector<detail::instruction> code_;
+    std::vector<std::pair<int, double>> constants_; // регистр и значение
+    int registers_ = 1;
+    int result_ = 0;                                // регистр результата
+};
+
+} // namespace integration
+
+#endif // EXPRESSION_H
@@ -0,0 +1,115 @@
+#ifndef FUNCTION_H
+#define FUNCTION_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+
+#include "simd.h"
+#include "vector_math.h"
+
+// Подынтегральные функции проекта в виде функторов.
+// Функтор передаётся в правила интегрирования как параметр шаблона,
+// поэтому компилятор встраивает вычисление f(x) прямо во внутренний цикл.
+
+// Функция f(x) = 1/(x^2 + 4x + 3)
+struct rational_function {
+    double operator()(double x) const {
+        double denominator = x * x + 4.0 * x + 3.0;
+        return 1.0 / denominator;
+    }
+
+    // Полюса - корни знаменателя (точки разбиения для breakpoints из rational.h)
+    std::array<double, 2> poles() const { return {-3.0, -1.0}; }
+
+    // Пакетная сумма по узлам start + (i + offset) * step - векторное ядро из simd.h
+    double sum_nodes(double start, double step, double offset,
+                     int first, int last, int stride) const {
+        if (last <= first) {
+            return 0.0;
+        }
+        std::int64_t count = (static_cast<std::int64_t>(last) - first + stride - 1) / stride;
+        return integration::simd::rational_sum(4.0, 3.0, start, step, first + offset,
+                                               count, stride);
+    }
+};
+
+// Функция sin(x² + 2.5) / (x³ + 3)
+struct sine_function {
+    double operator()(double x) const {
+        return std::sin(x * x + 2.5) / (x * x * x + 3);
+    }
+
+    // Пакетная сумма: синус блока узлов - векторной библиотекой vector_math.h
+    double sum_nodes(double start, double step, double offset,
+                     int first, int last, int stride) const {
+        return integration::vmath::sum_nodes(start, step, offset, first, last, stride,
+                                             [](const double* x, double* y, std::size_t count) {
+            for (std::size_t i = 0; i < count; i++) {
+                y[i] = x[i] * x[i] + 2.5;
+            }
+            integration::vmath::sin(y, y, count);
+            for (std::size_t i = 0; i < count; i++) {
+                y[i] /= x[i] * x[i] * x[i] + 3;
+            }
+        });
+    }
+};
+
+// Функция 1/√(x³ + 1)
+struct inverse_root_function {
+    double operator()(double x) const {
+        return 1.0 / std::sqrt(x * x * x + 1);
+    }
+
+    double sum_nodes(double start, double step, double offset,
+                     int first, int last, int stride) const {
+        return integration::vmath::sum_nodes(start, step, offset, first, last, stride,
+                                             [](const double* x, double* y, std::size_t count) {
+            for (std::size_t i = 0; i < count; i++) {
+                y[i] = x[i] * x[i] * x[i] + 1;
+            }
+            integration::vmath::sqrt(y, y, count);
+            for (std::size_t i = 0; i < count; i++) {
+                y[i] = 1.0 / y[i];
+            }
+        });
+    }
+};
+
+// Функция f(x) = 1 / cos(x)
+struct secant_function {
+    double operator()(double x) const {
+        double c = std::cos(x);
+        if (std::abs(c) < 1e-12) {
+            // Возвращаем бесконечность, если cos(x) близок к нулю
+            return std::numeric_limits<double>::infinity();
+        }
+        return 1.0 / c;
+    }
+
+    double sum_nodes(double start, double step, double offset,
+                     int first, int last, int stride) const {
+        return integration::vmath::sum_nodes(start, step, offset, first, last, stride,
+                                             [](const double* x, double* y, std::size_t count) {
+            integration::vmath::cos(x, y, count);
+            for (std::size_t i = 0; i < count; i++) {
+                y[i] = std::abs(y[i]) < 1e-12 ? std::numeric_limits<double>::infinity()
+                                              : 1.0 / y[i];
+            }
+        });
+    }
+};
+
+// Первообразная: F(x) = ln |sec x + tg x|
+struct secant_antiderivative {
+    double operator()(double x) const {
+        double sec = 1.0 / std::cos(x);
+        double tan = std::sin(x) / std::cos(x);
+        return std::log(std::abs(sec + tan));
+    }
+};
+
+#endif // FUNCTION_H
@@ -0,0 +1,203 @@
+#ifndef GAUSS_KRONROD_H
+#define GAUSS_KRONROD_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "instrumentation.h"
+
+// Адаптивное интегрирование по правилу Гаусса-Кронрода G7-K15.
+// Подынтервалы хранятся в куче, упорядоченной по оценке погрешности;
+// на каждом шаге пополам делится отрезок с наибольшей погрешностью, пока
+// суммарная погрешность не станет меньше max(abs_tol, rel_tol * |I|).
+// Узлы сами сгущаются там, где функция меняется быстро (например, вблизи
+// полюсов x = -1 и x = -3 функции 1/(x^2 + 4x + 3)).
+// Память под отрезки выделяется один раз (gauss_kronrod_workspace), поэтому
+// при делении отрезков обращений к куче нет.
+
+namespace integration {
+
+namespace detail {
+
+// Узлы Кронрода на [0, 1]; нечётные индексы - узлы Гаусса G7
+constexpr double kronrod15_nodes[8] = {
+    0.991455371120812639206854697526329, 0.949107912342758524526189684047851,
+    0.864864423359769072789712788640926, 0.741531185599394439863864773280788,
+    0.586087235467691130294144845693013, 0.405845151377397166906606412076961,
+    0.207784955007898467600689403773245, 0.000000000000000000000000000000000};
+
+constexpr double kronrod15_weights[8] = {
+    0.022935322010529224963732008058970, 0.063092092629978553290700663189204,
+    0.104790010322250183839876322541518, 0.140653259715525918745189590510238,
+    0.169004726639267902826583426598550, 0.190350578064785409913256402421014,
+    0.204432940075298892414161999234649, 0.209482141084727828012999174891714};
+
+// Веса Гаусса G7 для узлов kronrod15_nodes[1], [3], [5], [7]
+constexpr double gauss7_weights[4] = {
+    0.129484966168869693270611432679082, 0.279705391489276667901467771423780,
+    0.381830050505118944950369775488975, 0.417959183673469387755102040816327};
+
+} // namespace detail
+
+// Отрезок с оценками интеграла и погрешности
+struct kronrod_segment {
+    double a, b;
+    double value;
+    double error;
+    double roundoff; // погрешность округления 50 * eps * ∫|f|, меньше её error не бывает
+};
+
+// Правило G7-K15 на одном отрезке с оценкой погрешности как в QUADPACK
+template <typename Function>
+kronrod_segment gauss_kronrod15(Function& f, double a, double b) {
+    const double center = 0.5 * (a + b);
+    const double half = 0.5 * (b - a);
+    const double fc = f(center);
+
+    double fv1[7], fv2[7];
+    double resk = fc * detail::kronrod15_weights[7];
+    double resg = fc * detail::gauss7_weights[3];
+    double resabs = std::abs(resk);
+    for (int j = 0; j < 7; j++) {
+        double dx = half * detail::kronrod15_nodes[j];
+        fv1[j] = f(center - dx);
+        fv2[j] = f(center + dx);
+        double pair = fv1[j] + fv2[j];
+        resk += detail::kronrod15_weights[j] * pair;
+        resabs += detail::kronrod15_weights[j] * (std::abs(fv1[j]) + std::abs(fv2[j]));
+        if (j % 2 == 1) {
+            resg += detail::gauss7_weights[j / 2] * pair;
+        }
+    }
+
+    const double mean = 0.5 * resk;
+    double resasc = detail::kronrod15_weights[7] * std::abs(fc - mean);
+    for (int j = 0; j < 7; j++) {
+        resasc += detail::kronrod15_weights[j] * (std::abs(fv1[j] - mean) + std::abs(fv2[j] - mean));
+    }
+
+    const double scale = std::abs(half);
+    resabs *= scale;
+    resasc *= scale;
+    double error = std::abs((resk - resg) * half);
+    if (resasc != 0.0 && error != 0.0) {
+        error = resasc * std::min(1.0, std::pow(200.0 * error / resasc, 1.5));
+    }
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    const double roundoff = 50.0 * epsilon * resabs;
+    if (resabs > std::numeric_limits<double>::min() / (50.0 * epsilon)) {
+        error = std::max(roundoff, error);
+    }
+    return {a, b, resk * half, error, roundoff};
+}
+
+// Результат адаптивного интегрирования
+struct adaptive_result {
+    double value;              // приближённое значение интеграла
+    double error;              // оценка абсолютной погрешности
+    std::int64_t evaluations;  // число вычислений функции
+    int segments;              // число отрезков в итоговом разбиении
+    bool converged;            // достигнута ли требуемая точность
+};
+
+// Рабочая память адаптивного метода; её можно переиспользовать между вызовами
+struct gauss_kronrod_workspace {
+    explicit gauss_kronrod_workspace(std::size_t max_segments = 2000)
+        : capacity(max_segments) {
+        segments.reserve(capacity);
+    }
+
+    std::size_t capacity;                  // наибольшее число отрезков
+    std::vector<kronrod_segment> segments; // двоичная куча по error
+};
+
+template <typename Function>
+adaptive_result gauss_kronrod(Function f, double a, double b, double abs_tol, double rel_tol,
+                              gauss_kronrod_workspace& workspace) {
+    INTEGRATION_RULE_SCOPE("gauss_kronrod");
+    auto by_error = [](const kronrod_segment& x, const kronrod_segment& y) {
+        return x.error < y.error;
+    };
+    // Бесконечная или неопределённая погрешность означает расходящийся интеграл.
+    // Если погрешность сравнима с суммарной погрешностью округления, дальнейшее
+    // деление отрезков точность не улучшит - это тоже считается сходимостью.
+    auto accurate = [&](double value, double error, double roundoff) {
+        return std::isfinite(value) && std::isfinite(error) &&
+               (error <= std::max(abs_tol, rel_tol * std::abs(value)) || error <= 2.0 * roundoff);
+    };
+    std::vector<kronrod_segment>& heap = workspace.segments;
+    heap.clear();
+    heap.push_back(gauss_kronrod15(f, a, b));
+
+    double value = heap[0].value;
+    double error = heap[0].error;
+    double roundoff = heap[0].roundoff;
+    std::int64_t evaluations = 15;
+    bool converged = false;
+
+    for (;;) {
+        if (accurate(value, error, roundoff)) {
+            // Перед остановкой пересчитываем суммы, чтобы не накопить ошибку округления
+            value = error = roundoff = 0.0;
+            for (const kronrod_segment& segment : heap) {
+                value += segment.value;
+                error += segment.error;
+                roundoff += segment.roundoff;
+            }
+            if (accurate(value, error, roundoff)) {
+                converged = true;
+                break;
+            }
+        }
+        if (heap.size() >= workspace.capacity) {
+            break;
+        }
+
+        std::pop_heap(heap.begin(), heap.end(), by_error);
+        kronrod_segment worst = heap.back();
+        double middle = 0.5 * (worst.a + worst.b);
+        if (!(worst.a < middle && middle < worst.b)) {
+            // Отрезок больше не делится в арифметике double
+            std::push_heap(heap.begin(), heap.end(), by_error);
+            break;
+        }
+
+        kronrod_segment left = gauss_kronrod15(f, worst.a, middle);
+        kronrod_segment right = gauss_kronrod15(f, middle, worst.b);
+        evaluations += 30;
+        value += left.value + right.value - worst.value;
+        error += left.error + right.error - worst.error;
+        roundoff += left.roundoff + right.roundoff - worst.roundoff;
+
+        heap.back() = left;
+        std::push_heap(heap.begin(), heap.end(), by_error);
+        heap.push_back(right);
+        std::push_heap(heap.begin(), heap.end(), by_error);
+    }
+
+    if (!converged) {
+        value = error = 0.0;
+        for (const kronrod_segment& segment : heap) {
+            value += segment.value;
+            error += segment.error;
+        }
+    }
+    INTEGRATION_COUNT_EVALUATIONS(evaluations);
+    return {value, error, evaluations, static_cast<int>(heap.size()), converged};
+}
+
+// Вариант с собственной рабочей памятью
+template <typename Function>
+adaptive_result gauss_kronrod(Function f, double a, double b, double abs_tol,
+                              double rel_tol = 0.0, std::size_t max_segments = 2000) {
+    gauss_kronrod_workspace workspace(max_segments);
+    return gauss_kronrod(std::move(f), a, b, abs_tol, rel_tol, workspace);
+}
+
+} // namespace integration
+
+#endif // GAUSS_KRONROD_H
@@ -0,0 +1,178 @@
+#ifndef GAUSS_LEGENDRE_H
+#define GAUSS_LEGENDRE_H
+
+#include <array>
+#include <cstddef>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "instrumentation.h"
+
+// Квадратуры Гаусса-Лежандра порядков 1..64.
+// Узлы и веса вычисляются во время компиляции (constexpr-метод Ньютона
+// для многочленов Лежандра), поэтому при запуске программы никаких
+// вычислений таблиц нет. Правило порядка N точно для многочленов степени
+// 2N - 1; gauss_legendre<1> совпадает с правилом средних точек.
+// Результат имеет тип значений f (double или дуальное число из dual.h).
+
+namespace integration {
+
+constexpr int gauss_legendre_max_order = 64;
+
+namespace detail {
+
+constexpr double gl_pi = 3.14159265358979323846264338327950288;
+
+constexpr double constexpr_abs(double x) { return x < 0 ? -x : x; }
+
+// cos(x) для x из [0, pi] рядом Тейлора (нужен только как начальное приближение)
+constexpr double constexpr_cos(double x) {
+    double term = 1.0;
+    double sum = 1.0;
+    for (int k = 1; k < 40; k++) {
+        term *= -x * x / ((2 * k - 1) * (2 * k));
+        sum += term;
+    }
+    return sum;
+}
+
+// P_n(x) и P_n'(x) по трёхчленной рекуррентной формуле
+constexpr std::pair<double, double> legendre(int n, double x) {
+    double p0 = 1.0;
+    double p1 = x;
+    for (int k = 2; k <= n; k++) {
+        double p2 = ((2 * k - 1) * x * p1 - (k - 1) * p0) / k;
+        p0 = p1;
+        p1 = p2;
+    }
+    double derivative = n * (x * p1 - p0) / (x * x - 1.0);
+    return {p1, derivative};
+}
+
+// Составное правило по таблице из order узлов на parts отрезках;
+// при parts <= 0 - NaN
+template <typename Function>
+auto gauss_legendre_sum(Function& f, double a, double b, const double* nodes,
+                        const double* weights, int order, int parts) {
+    INTEGRATION_RULE_SCOPE("gauss_legendre");
+    using value_type = std::decay_t<decltype(f(a))>;
+    if (parts <= 0) {
+        std::cerr << "Ошибка: n должно быть положительным" << std::endl;
+        return value_type(std::numeric_limits<double>::quiet_NaN());
+    }
+    INTEGRATION_COUNT_EVALUATIONS(static_cast<std::int64_t>(order) * parts);
+    double h = (b - a) / parts;
+    double half = 0.5 * h;
+    value_type total = 0.0;
+    for (int i = 0; i < parts; i++) {
+        double center = a + (i + 0.5) * h;
+        value_type sum = 0.0;
+        for (int k = 0; k < order; k++) {
+            sum += weights[k] * f(center + half * nodes[k]);
+        }
+        total += sum;
+    }
+    return total * half;
+}
+
+} // namespace detail
+
+// Таблица узлов и весов на [-1, 1]
+template <int N>
+struct gauss_legendre_table {
+    static_assert(N >= 1 && N <= gauss_legendre_max_order, "порядок от 1 до 64");
+
+    std::array<double, N> nodes{};
+    std::array<double, N> weights{};
+
+    static constexpr gauss_legendre_table build() {
+        gauss_legendre_table table{};
+        if (N == 1) {
+            table.nodes[0] = 0.0;
+            table.weights[0] = 2.0;
+            return table;
+        }
+        for (int i = 0; i < (N + 1) / 2; i++) {
+            // Начальное приближение к i-му корню и уточнение методом Ньютона
+            double x = detail::constexpr_cos(detail::gl_pi * (i + 0.75) / (N + 0.5));
+            for (int iteration = 0; iteration < 100; iteration++) {
+                auto p = detail::legendre(N, x);
+                double dx = p.first / p.second;
+                x -= dx;
+                if (detail::constexpr_abs(dx) < 1e-16) {
+                    break;
+                }
+            }
+            double derivative = detail::legendre(N, x).second;
+            double weight = 2.0 / ((1.0 - x * x) * derivative * derivative);
+            table.nodes[i] = -x;
+            table.weights[i] = weight;
+            table.nodes[N - 1 - i] = x;
+            table.weights[N - 1 - i] = weight;
+        }
+        if (N % 2 == 1) {
+            table.nodes[N / 2] = 0.0; // центральный узел точно в нуле
+        }
+        return table;
+    }
+};
+
+// Готовые таблицы - константы времени компиляции
+template <int N>
+constexpr gauss_legendre_table<N> gauss_legendre_nodes = gauss_legendre_table<N>::build();
+
+// Составное правило Гаусса-Лежандра порядка N на parts отрезках (parts <= 0 - NaN)
+template <int N, typename Function>
+auto gauss_legendre(Function&& f, double a, double b, int parts = 1) {
+    constexpr const gauss_legendre_table<N>& table = gauss_legendre_nodes<N>;
+    return detail::gauss_legendre_sum(f, a, b, table.nodes.data(), table.weights.data(), N, parts);
+}
+
+// Таблица для порядка, известного только во время выполнения
+struct gauss_legendre_view {
+    int order;
+    const double* nodes;
+    const double* weights;
+};
+
+namespace detail {
+
+template <std::size_t... Orders>
+constexpr std::array<gauss_legendre_view, sizeof...(Orders)>
+make_gauss_legendre_views(std::index_sequence<Orders...>) {
+    return {{gauss_legendre_view{static_cast<int>(Orders) + 1,
+                                 gauss_legendre_nodes<Orders + 1>.nodes.data(),
+                                 gauss_legendre_nodes<Orders + 1>.weights.data()}...}};
+}
+
+constexpr std::array<gauss_legendre_view, gauss_legendre_max_order> gauss_legendre_views =
+    make_gauss_legendre_views(std::make_index_sequence<gauss_legendre_max_order>());
+
+} // namespace detail
+
+// Таблица порядка order (1..64); для других порядков order == 0
+inline gauss_legendre_view gauss_legendre_rule(int order) {
+    if (order < 1 || order > gauss_legendre_max_order) {
+        return {0, nullptr, nullptr};
+    }
+    return detail::gauss_legendre_views[order - 1];
+}
+
+// Составное правило Гаусса-Лежандра с порядком, выбранным во время выполнения;
+// при порядке вне 1..64 или parts <= 0 - NaN
+template <typename Function>
+auto gauss_legendre(Function&& f, double a, double b, int order, int parts) {
+    gauss_legendre_view rule = gauss_legendre_rule(order);
+    if (rule.order == 0) {
+        std::cerr << "Ошибка: порядок Гаусса-Лежандра должен быть от 1 до "
+                  << gauss_legendre_max_order << std::endl;
+        return std::decay_t<decltype(f(a))>(std::numeric_limits<double>::quiet_NaN());
+    }
+    return detail::gauss_legendre_sum(f, a, b, rule.nodes, rule.weights, rule.order, parts);
+}
+
+} // namespace integration
+
+#endif // GAUSS_LEGENDRE_H
@@ -0,0 +1,347 @@
+#ifndef INSTRUMENTATION_H
+#define INSTRUMENTATION_H
+
+// Инструментирование горячих путей (включается -DINTEGRATION_INSTRUMENT,
+// в Makefile - make INSTRUMENT=1). Без этого макроса все точки замера
+// раскрываются в пустые выражения и код правил не меняется.
+//
+// Что собирается:
+//  - по каждому правилу: число вызовов, число вычислений f и время.
+//    Вычисления считаются там, где правило запрашивает узлы (политики
+//    выполнения, вызовы f на концах), а не внутри f, поэтому векторные
+//    ядра функторов учитываются так же, как скалярный цикл. Вложенные
+//    правила входят в объемлющие (cauchy_principal_value включает свои
+//    midpoint_rule).
+//  - по каждой задаче (INTEGRATION_TASK в программе): время, все
+//    вычисления f и, если задана переменная окружения INTEGRATION_PERF,
+//    такты, инструкции и промахи кэша через perf_event_open. Аппаратные
+//    счётчики относятся к потоку, который выполняет задачу: работа потоков
+//    пула в них не входит (INTEGRATION_THREADS=1 - полный счёт).
+//  - по каждой строке таблиц сходимости (sweep.h): n, время, вычисления.
+//
+// При завершении программы сводка в формате JSON пишется в файл из
+// переменной окружения INTEGRATION_PROFILE или в stderr.
+
+#ifdef INTEGRATION_INSTRUMENT
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace integration {
+namespace instrument {
+
+using clock = std::chrono::steady_clock;
+
+inline double seconds_since(clock::time_point start) {
+    return std::chrono::duration<double>(clock::now() - start).count();
+}
+
+// Вычисления f, запрошенные в текущем потоке (для правил и строк таблиц)
+inline std::int64_t& thread_evaluations() {
+    thread_local std::int64_t count = 0;
+    return count;
+}
+
+// Все вычисления f во всех потоках (для задач)
+inline std::atomic<std::int64_t>& total_evaluations() {
+    static std::atomic<std::int64_t> count{0};
+    return count;
+}
+
+inline void count_evaluations(std::int64_t count) {
+    thread_evaluations() += count;
+    total_evaluations().fetch_add(count, std::memory_order_relaxed);
+}
+
+// Такты, инструкции и промахи кэша вызывающего потока
+class hardware_counters {
+public:
+    static constexpr int count = 3;
+
+    hardware_counters() {
+        const char* env = std::getenv("INTEGRATION_PERF");
+        if (!env || !*env || std::string(env) == "0") {
+            return;
+        }
+#ifdef __linux__
+        const std::uint64_t events[count] = {PERF_COUNT_HW_CPU_CYCLES, PERF_COUNT_HW_INSTRUCTIONS,
+                                             PERF_COUNT_HW_CACHE_MISSES};
+        for (int i = 0; i < count; i++) {
+            perf_event_attr attr{};
+            attr.size = sizeof(attr);
+            attr.type = PERF_TYPE_HARDWARE;
+            attr.config = events[i];
+            attr.exclude_kernel = 1;
+            attr.exclude_hv = 1;
+            fd_[i] = static_cast<int>(syscall(SYS_perf_event_open, &attr, 0, -1, -1, 0));
+            if (fd_[i] < 0) {
+                close_all();
+                std::fprintf(stderr, "Предупреждение: perf_event_open недоступен, "
+                                     "аппаратные счётчики отключены\n");
+                return;
+            }
+        }
+        available_ = true;
+#endif
+    }
+
+    ~hardware_counters() { close_all(); }
+
+    bool available() const { return available_; }
+
+    // Текущие значения счётчиков (нули, если они недоступны)
+    void read(std::uint64_t (&values)[count]) const {
+        for (int i = 0; i < count; i++) {
+            values[i] = 0;
+#ifdef __linux__
+            if (available_ && ::read(fd_[i], &values[i], sizeof(values[i])) != sizeof(values[i])) {
+                values[i] = 0;
+            }
+#endif
+        }
+    }
+
+private:
+    void close_all() {
+#ifdef __linux__
+        for (int& fd : fd_) {
+            if (fd >= 0) {
+                ::close(fd);
+                fd = -1;
+            }
+        }
+#endif
+    }
+
+    int fd_[count] = {-1, -1, -1};
+    bool available_ = false;
+};
+
+// Накопленные данные; сводка пишется в деструкторе (при выходе из программы)
+class registry {
+public:
+    static registry& instance() {
+        static registry r;
+        return r;
+    }
+
+    void record_rule(const char* name, std::int64_t evaluations, double seconds) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rule_stats& stats = rules_[name];
+        stats.calls++;
+        stats.evaluations += evaluations;
+        stats.seconds += seconds;
+    }
+
+    void record_row(const char* sweep, int n, std::int64_t evaluations, double seconds) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        rows_.push_back({sweep, n, evaluations, seconds});
+    }
+
+    // Начать задачу name, завершив предыдущую
+    void begin_task(const char* name) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finish_task();
+        open_ = true;
+        task_ = {name, 0, 0.0, {}};
+        task_start_ = clock::now();
+        task_evaluations_ = total_evaluations().load(std::memory_order_relaxed);
+        counters_.read(task_counters_);
+    }
+
+    void end_task() {
+        std::lock_guard<std::mutex> lock(mutex_);
+        finish_task();
+    }
+
+    ~registry() {
+        finish_task();
+        std::FILE* out = stderr;
+        const char* path = std::getenv("INTEGRATION_PROFILE");
+        if (path && *path) {
+            out = std::fopen(path, "w");
+            if (!out) {
+                std::fprintf(stderr, "Ошибка: не удалось открыть %s\n", path);
+                out = stderr;
+            }
+        }
+        write(out);
+        if (out != stderr) {
+            std::fclose(out);
+        }
+    }
+
+private:
+    struct rule_stats {
+        std::int64_t calls = 0;
+        std::int64_t evaluations = 0;
+        double seconds = 0.0;
+    };
+    struct row_record {
+        std::string sweep;
+        int n;
+        std::int64_t evaluations;
+        double seconds;
+    };
+    struct task_record {
+        std::string name;
+        std::int64_t evaluations;
+        double seconds;
+        std::uint64_t counters[hardware_counters::count];
+    };
+
+    registry() = default;
+
+    void finish_task() {
+        if (!open_) {
+            return;
+        }
+        open_ = false;
+        task_.seconds = seconds_since(task_start_);
+        task_.evaluations = total_evaluations().load(std::memory_order_relaxed) - task_evaluations_;
+        std::uint64_t now[hardware_counters::count];
+        counters_.read(now);
+        for (int i = 0; i < hardware_counters::count; i++) {
+            task_.counters[i] = now[i] - task_counters_[i];
+        }
+        tasks_.push_back(task_);
+    }
+
+    static std::string quoted(const std::string& text) {
+        std::string out = "\"";
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out += '\\';
+            }
+            out += c;
+        }
+        return out + "\"";
+    }
+
+    void write(std::FILE* out) const {
+        std::fprintf(out, "{\"rules\": [");
+        const char* separator = "";
+        for (const auto& rule : rules_) {
+            std::fprintf(out, "%s\n  {\"name\": %s, \"calls\": %lld, \"evaluations\": %lld, "
+                              "\"seconds\": %.9g}",
+                         separator, quoted(rule.first).c_str(),
+                         static_cast<long long>(rule.second.calls),
+                         static_cast<long long>(rule.second.evaluations), rule.second.seconds);
+            separator = ",";
+        }
+        std::fprintf(out, "],\n \"tasks\": [");
+        separator = "";
+        for (const task_record& task : tasks_) {
+            std::fprintf(out, "%s\n  {\"name\": %s, \"evaluations\": %lld, \"seconds\": %.9g",
+                         separator, quoted(task.name).c_str(),
+                         static_cast<long long>(task.evaluations), task.seconds);
+            if (counters_.available()) {
+                std::fprintf(out, ", \"cycles\": %llu, \"instructions\": %llu, \"cache_misses\": %llu",
+                             static_cast<unsigned long long>(task.counters[0]),
+                             static_cast<unsigned long long>(task.counters[1]),
+                             static_cast<unsigned long long>(task.counters[2]));
+            }
+            std::fprintf(out, "}");
+            separator = ",";
+        }
+        std::fprintf(out, "],\n \"sweep_rows\": [");
+        separator = "";
+        for (const row_record& row : rows_) {
+            std::fprintf(out, "%s\n  {\"sweep\": %s, \"n\": %d, \"evaluations\": %lld, "
+                              "\"seconds\": %.9g}",
+                         separator, quoted(row.sweep).c_str(), row.n,
+                         static_cast<long long>(row.evaluations), row.seconds);
+            separator = ",";
+        }
+        std::fprintf(out, "]}\n");
+    }
+
+    std::mutex mutex_;
+    std::map<std::string, rule_stats> rules_;
+    std::vector<row_record> rows_;
+    std::vector<task_record> tasks_;
+    hardware_counters counters_;
+    bool open_ = false;
+    task_record task_{};
+    clock::time_point task_start_;
+    std::int64_t task_evaluations_ = 0;
+    std::uint64_t task_counters_[hardware_counters::count] = {};
+};
+
+// Вызов правила: время и вычисления f от создания до разрушения
+class rule_scope {
+public:
+    explicit rule_scope(const char* name)
+        : name_(name), start_(clock::now()), evaluations_(thread_evaluations()) {}
+    ~rule_scope() {
+        registry::instance().record_rule(name_, thread_evaluations() - evaluations_,
+                                         seconds_since(start_));
+    }
+
+    rule_scope(const rule_scope&) = delete;
+    rule_scope& operator=(const rule_scope&) = delete;
+
+private:
+    const char* name_;
+    clock::time_point start_;
+    std::int64_t evaluations_;
+};
+
+// Строка таблицы сходимости. Строка может выполняться потоком, который
+// ждёт свою строку (перехват работы в пуле), поэтому при выходе счётчик
+// потока возвращается к начальному значению: вычисления чужой строки
+// не попадают в объемлющую
+class row_scope {
+public:
+    row_scope(const char* sweep, int n)
+        : sweep_(sweep), n_(n), start_(clock::now()), evaluations_(thread_evaluations()) {}
+    ~row_scope() {
+        registry::instance().record_row(sweep_, n_, thread_evaluations() - evaluations_,
+                                        seconds_since(start_));
+        thread_evaluations() = evaluations_;
+    }
+
+    row_scope(const row_scope&) = delete;
+    row_scope& operator=(const row_scope&) = delete;
+
+private:
+    const char* sweep_;
+    int n_;
+    clock::time_point start_;
+    std::int64_t evaluations_;
+};
+
+} // namespace instrument
+} // namespace integration
+
+#define INTEGRATION_COUNT_EVALUATIONS(count) ::integration::instrument::count_evaluations(count)
+#define INTEGRATION_RULE_SCOPE(name) ::integration::instrument::rule_scope integration_rule_scope_(name)
+#define INTEGRATION_ROW_SCOPE(sweep, n) ::integration::instrument::row_scope integration_row_scope_(sweep, n)
+#define INTEGRATION_TASK(name) ::integration::instrument::registry::instance().begin_task(name)
+#define INTEGRATION_TASK_END() ::integration::instrument::registry::instance().end_task()
+
+#else
+
+#define INTEGRATION_COUNT_EVALUATIONS(count) ((void)0)
+#define INTEGRATION_RULE_SCOPE(name) ((void)0)
+#define INTEGRATION_ROW_SCOPE(sweep, n) ((void)0)
+#define INTEGRATION_TASK(name) ((void)0)
+#define INTEGRATION_TASK_END() ((void)0)
+
+#endif // INTEGRATION_INSTRUMENT
+
+#endif // INSTRUMENTATION_H
@@ -0,0 +1,257 @@
+#ifndef INTEGRATION_H
+#define INTEGRATION_H
+
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <type_traits>
+#include <utility>
+
+#include "instrumentation.h"
+#include "summation.h"
+
+// Правила численного интегрирования.
+// Все правила - шаблоны по типу подынтегральной функции (лямбда или функтор),
+// поэтому вызов f(x) встраивается во внутренний цикл и для каждой функции
+// получается своя специализированная версия без косвенных вызовов.
+// Правила rectangles, midpoint_rule, trapezoid и simpson возвращают значение
+// того же типа, что и f: если f возвращает дуальное число (dual.h), вместе с
+// интегралом получается его градиент по параметрам f.
+
+namespace integration {
+
+namespace detail {
+
+// Тип значений f(x): double или, например, dual<N>
+template <typename Function>
+using value_type = std::decay_t<std::invoke_result_t<Function&, double>>;
+
+// Функтор может предоставить пакетный метод
+// sum_nodes(start, step, offset, first, last, stride) - например, векторное ядро
+template <typename Function, typename = void>
+struct has_batch_sum : std::false_type {};
+
+template <typename Function>
+struct has_batch_sum<Function, std::void_t<decltype(std::declval<Function&>().sum_nodes(
+                                   0.0, 0.0, 0.0, 0, 0, 1))>> : std::true_type {};
+
+// Число узлов i = first, first + stride, ... < last
+inline std::int64_t node_count(int first, int last, int stride) {
+    return last > first ? (static_cast<std::int64_t>(last) - first + stride - 1) / stride : 0;
+}
+
+// Общий внутренний цикл всех правил:
+// сумма f(start + (i + offset) * step) для i = first, first + stride, ... < last
+template <typename Function>
+value_type<Function> sum_nodes(Function& f, double start, double step, double offset,
+                               int first, int last, int stride = 1) {
+    if constexpr (has_batch_sum<Function>::value) {
+        return f.sum_nodes(start, step, offset, first, last, stride);
+    } else {
+        value_type<Function> total = 0.0;
+        for (int i = first; i < last; i += stride) {
+            total += f(start + (i + offset) * step);
+        }
+        return total;
+    }
+}
+
+} // namespace detail
+
+// Последовательное выполнение: все узлы суммируются в вызывающем потоке.
+// Правила принимают политику выполнения последним параметром; параллельная
+// политика (parallel.h) предоставляет тот же метод sum_nodes.
+// sequential_execution{summation_mode::reproducible} даёт те же биты, что и
+// параллельная политика в этом режиме (summation.h).
+struct sequential_execution {
+    summation_mode mode = summation_mode::fast;
+
+    template <typename Function>
+    detail::value_type<Function> sum_nodes(Function& f, double start, double step, double offset,
+                                           int first, int last, int stride = 1) const {
+        INTEGRATION_COUNT_EVALUATIONS(detail::node_count(first, last, stride));
+        if (mode == summation_mode::reproducible) {
+            exact_accumulator<detail::value_type<Function>> total;
+            detail::sum_nodes_exact(f, start, step, offset, first, last, stride, total);
+            return total.value();
+        }
+        return detail::sum_nodes(f, start, step, offset, first, last, stride);
+    }
+};
+
+// Метод левых прямоугольников
+template <typename Function, typename Execution = sequential_execution>
+auto rectangles(Function&& f, double start, double end, int parts,
+                  const Execution& execution = Execution()) {
+    INTEGRATION_RULE_SCOPE("rectangles");
+    // Ширина одного прямоугольника
+    double step = (end - start) / parts;
+    // Сумма высот (значений в левых концах) умножается на ширину
+    return execution.sum_nodes(f, start, step, 0.0, 0, parts) * step;
+}
+
+// Метод средних точек
+template <typename Function, typename Execution = sequential_execution>
+auto midpoint_rule(Function&& f, double a, double b, int n,
+                   const Execution& execution = Execution()) {
+    INTEGRATION_RULE_SCOPE("midpoint_rule");
+    if (n <= 0) {
+        std::cerr << "Ошибка: n должно быть положительным" << std::endl;
+        return detail::value_type<Function>(std::numeric_limits<double>::quiet_NaN());
+    }
+
+    double h = (b - a) / n;
+    return execution.sum_nodes(f, a, h, 0.5, 0, n) * h;
+}
+
+// Метод трапеций (parts - на сколько частей разбиваем интервал)
+template <typename Function, typename Execution = sequential_execution>
+auto trapezoid(Function&& f, double start, double end, int parts,
+               const Execution& execution = Execution()) {
+    INTEGRATION_RULE_SCOPE("trapezoid");
+    INTEGRATION_COUNT_EVALUATIONS(2);
+    double step = (end - start) / parts;
+    // Полусумма значений на краях плюс значения во внутренних точках
+    detail::value_type<Function> total = (f(start) + f(end)) / 2;
+    total += execution.sum_nodes(f, start, step, 0.0, 1, parts);
+    return total * step;
+}
+
+// Метод Симпсона (требует чётного числа отрезков)
+template <typename Function, typename Execution = sequential_execution>
+auto simpson(Function&& f, double start, double end, int parts,
+             const Execution& execution = Execution()) {
+    INTEGRATION_RULE_SCOPE("simpson");
+    INTEGRATION_COUNT_EVALUATIONS(2);
+    if (parts % 2 != 0) {
+        parts++; // Если передали нечётное - делаем чётным
+    }
+    double step = (end - start) / parts;
+    // Значения на краях, затем чётные точки с коэффициентом 2 и нечётные с 4
+    detail::value_type<Function> total = f(start) + f(end);
+    total += 2 * execution.sum_nodes(f, start, step, 0.0, 2, parts, 2);
+    total += 4 * execution.sum_nodes(f, start, step, 0.0, 1, parts, 2);
+    return total * step / 3;
+}
+
+// Оценки нескольких правил по одной выборке значений функции
+struct rule_estimates {
+    double left;       // левые прямоугольники, n частей
+    double right;      // правые прямоугольники, n частей
+    double midpoint;   // средние точки, n частей
+    double trapezoid;  // трапеции, n частей
+    double simpson;    // Симпсон на сетке h/2 (2n частей)
+    double error;      // |трапеции - средние точки| - погрешность правил второго
+                       // порядка (у средних точек около 1/3 от неё, у трапеций 2/3)
+    std::int64_t evaluations; // число вычислений функции (2n + 1)
+};
+
+// Все правила сразу: f вычисляется один раз на сетке с шагом h/2.
+// Чётные узлы этой сетки - узлы трапеций и прямоугольников, нечётные -
+// середины отрезков, поэтому вместо n + (n + 1) + n вычислений по отдельности
+// нужно 2n + 1.
+template <typename Function, typename Execution = sequential_execution>
+rule_estimates fused_rules(Function&& f, double a, double b, int n,
+                           const Execution& execution = Execution()) {
+    INTEGRATION_RULE_SCOPE("fused_rules");
+    if (n <= 0) {
+        std::cerr << "Ошибка: n должно быть положительным" << std::endl;
+        double nan = std::numeric_limits<double>::quiet_NaN();
+        return {nan, nan, nan, nan, nan, nan, 0};
+    }
+    double h = (b - a) / n;
+    INTEGRATION_COUNT_EVALUATIONS(2);
+    double fa = f(a);
+    double fb = f(b);
+    double interior = execution.sum_nodes(f, a, h, 0.0, 1, n);   // a + i h, 0 < i < n
+    double midpoints = execution.sum_nodes(f, a, h, 0.5, 0, n);  // a + (i + 0.5) h
+
+    rule_estimates result;
+    result.left = h * (fa + interior);
+    result.right = h * (interior + fb);
+    result.midpoint = h * midpoints;
+    result.trapezoid = h * ((fa + fb) / 2 + interior);
+    result.simpson = h / 6 * (fa + fb + 2 * interior + 4 * midpoints);
+    result.error = std::abs(result.trapezoid - result.midpoint);
+    result.evaluations = 2 * static_cast<std::int64_t>(n) + 1;
+    return result;
+}
+
+// Численное вычисление главного значения по Коши с использованием симметричного обхода особенности
+template <typename Function, typename Execution = sequential_execution>
+double cauchy_principal_value(Function&& f, double a, double b, int n, double singularity,
+                              const Execution& execution = Execution()) {
+    INTEGRATION_RULE_SCOPE("cauchy_principal_value");
+    // Если особенность находится вне интервала, вычисляем обычный интеграл
+    if (singularity <= a || singularity >= b) {
+        return midpoint_rule(f, a, b, n, execution);
+    }
+
+    double left_distance = singularity - a;
+    double right_distance = b - singularity;
+    double min_distance = (left_distance < right_distance) ? left_distance : right_distance;
+    double interval_size = b - a;
+
+    // Используем epsilon, пропорциональный размеру интервала и количеству узлов
+    double epsilon = interval_size / (n * 50.0);
+
+    // Ограничиваем epsilon снизу для численной устойчивости
+    double min_epsilon = 1e-8;
+    if (epsilon < min_epsilon) {
+        epsilon = min_epsilon;
+    }
+    // Ограничиваем сверху: максимум 10% от минимального расстояния до особенности
+    double max_epsilon = min_distance * 0.1;
+    if (epsilon > max_epsilon) {
+        epsilon = max_epsilon;
+    }
+
+    double left_end = singularity - epsilon;
+    double right_start = singularity + epsilon;
+
+    // Распределяем узлы пропорционально длине каждой части
+    double left_length = left_end - a;
+    double right_length = b - right_start;
+    double total_length = left_length + right_length;
+
+    if (total_length < 1e-10) {
+        return 0.0; // Интервал слишком мал
+    }
+
+    int n_left = static_cast<int>(n * left_length / total_length + 0.5);
+    int n_right = n - n_left;
+
+    // Гарантируем минимум по 1 узлу на каждую часть
+    if (n_left < 1) {
+        n_left = 1;
+        n_right = n - 1;
+        if (n_right < 1) n_right = 1;
+    }
+    if (n_right < 1) {
+        n_right = 1;
+        n_left = n - 1;
+        if (n_left < 1) n_left = 1;
+    }
+
+    // Если общее количество узлов слишком мало, распределяем более равномерно
+    if (n < 4) {
+        n_left = (n + 1) / 2;
+        n_right = n - n_left;
+    }
+
+    // Интегрируем левую и правую части методом средних точек
+    double left_integral = midpoint_rule(f, a, left_end, n_left, execution);
+    double right_integral = midpoint_rule(f, right_start, b, n_right, execution);
+
+    if (std::isnan(left_integral) || std::isnan(right_integral) ||
+        std::isinf(left_integral) || std::isinf(right_integral)) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+
+    return left_integral + right_integral;
+}
+
+} // namespace integration
+
+#endif // INTEGRATION_H
@@ -0,0 +1,104 @@
+#ifndef INTEGRATION_C_H
+#define INTEGRATION_C_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// C-интерфейс библиотеки libintegration (static и shared, см. Makefile).
+// Подынтегральная функция - встроенная (function.h) или функция вызывающей
+// стороны с контекстом. Результаты пишутся в память вызывающей стороны;
+// после первого вызова в потоке (рабочая память Гаусса-Кронрода) ни один
+// вызов не выделяет память, а если выделить её не удалось, возвращается
+// INTEGRATION_OUT_OF_MEMORY - исключения C++ через интерфейс не проходят.
+// Функции возвращают код состояния integration_status, описание -
+// integration_status_message.
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+typedef enum {
+    INTEGRATION_OK = 0,
+    INTEGRATION_INVALID_ARGUMENT = 1,  // нулевой указатель, n вне 1..INT_MAX-1, tol <= 0,
+                                       // order вне 1..64, order * n > INT_MAX-1
+    INTEGRATION_UNKNOWN_RULE = 2,
+    INTEGRATION_UNKNOWN_FUNCTION = 3,
+    INTEGRATION_OUT_OF_MEMORY = 4,     // не удалось выделить рабочую память
+    INTEGRATION_INTERNAL_ERROR = 5     // другое исключение внутри библиотеки
+} integration_status;
+
+typedef enum {
+    INTEGRATION_RECTANGLES = 0,       // левые прямоугольники, n частей
+    INTEGRATION_MIDPOINT = 1,         // средние точки, n частей
+    INTEGRATION_TRAPEZOID = 2,        // трапеции, n частей
+    INTEGRATION_SIMPSON = 3,          // Симпсон, n частей (чётное)
+    INTEGRATION_GAUSS_LEGENDRE = 4,   // order узлов на каждой из n частей
+    INTEGRATION_GAUSS_KRONROD = 5,    // адаптивный, погрешность tol
+    INTEGRATION_TANH_SINH = 6,        // tanh-sinh, погрешность tol
+    INTEGRATION_CAUCHY = 7,           // главное значение средними точками, n частей
+    INTEGRATION_PRINCIPAL_VALUE = 8   // главное значение парами узлов Гаусса, tol
+} integration_rule;
+
+typedef enum {
+    INTEGRATION_RATIONAL = 0,         // 1/(x^2 + 4x + 3)
+    INTEGRATION_SINE = 1,             // sin(x^2 + 2.5)/(x^3 + 3)
+    INTEGRATION_INVERSE_ROOT = 2,     // 1/sqrt(x^3 + 1)
+    INTEGRATION_SECANT = 3            // 1/cos(x)
+} integration_function;
+
+// Подынтегральная функция вызывающей стороны
+typedef double (*integration_callback)(double x, void* context);
+
+typedef struct {
+    integration_rule rule;
+    double a, b;            // пределы интегрирования
+    int n;                  // число частей (правила с фиксированной сеткой)
+    int order;              // узлов Гаусса-Лежандра на части
+    double tol;             // абсолютная погрешность адаптивных правил
+    double singularity;     // полюс для INTEGRATION_CAUCHY и INTEGRATION_PRINCIPAL_VALUE
+} integration_request;
+
+typedef struct {
+    double value;
+    double error;           // оценка погрешности (NaN у правил без оценки)
+    int64_t evaluations;    // число вычислений функции
+    int converged;          // 1, если достигнута точность (у правил без оценки - 1)
+} integration_result;
+
+// Запрос со значениями по умолчанию: n = 1000, order = 16, tol = 1e-10, без полюса
+integration_request integration_default_request(integration_rule rule, double a, double b);
+
+// Встроенная функция и правило по имени: "rational", "sine", "inverse_root", "secant";
+// "rectangles", "midpoint", "trapezoid", "simpson", "gauss_legendre", "gauss_kronrod",
+// "tanh_sinh", "cauchy", "principal_value"
+integration_status integration_function_by_name(const char* name, integration_function* function);
+integration_status integration_rule_by_name(const char* name, integration_rule* rule);
+
+// Интеграл встроенной функции
+integration_status integration_integrate(integration_function function,
+                                         const integration_request* request,
+                                         integration_result* result);
+
+// Интеграл функции вызывающей стороны: callback(x, context)
+integration_status integration_integrate_callback(integration_callback callback, void* context,
+                                                  const integration_request* request,
+                                                  integration_result* result);
+
+// count запросов к встроенной функции; results[i] - ответ на requests[i].
+// Возвращает первый ненулевой код, остальные запросы всё равно выполняются
+integration_status integration_integrate_batch(integration_function function,
+                                               const integration_request* requests,
+                                               integration_result* results, size_t count);
+
+// y[i] = f(x[i]) для встроенной функции
+integration_status integration_evaluate(integration_function function, const double* x,
+                                        double* y, size_t count);
+
+// Описание кода состояния (статическая строка)
+const char* integration_status_message(integration_status status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INTEGRATION_C_H
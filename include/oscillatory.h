@@ -0,0 +1,296 @@
+#ifndef OSCILLATORY_H
+#define OSCILLATORY_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "instrumentation.h"
+
+// Осциллирующие интегралы вида
+//   C = ∫ g(x) cos ω(x) dx,   S = ∫ g(x) sin ω(x) dx
+// методом коллокации Левина. Ищется функция p(x) с
+//   p'(x) + i ω'(x) p(x) = g(x),
+// тогда C + i S = p(b) e^{i ω(b)} - p(a) e^{i ω(a)}. Если ω' не обращается
+// в ноль, p гладкая и не осциллирует, поэтому её многочлен Чебышёва низкой
+// степени даёт точный результат при любой частоте: число вычислений не
+// растёт с ω. Уравнение решается коллокацией в точках Чебышёва-Лобатто,
+// ω' находится дифференцированием интерполянта ω в тех же точках, так что
+// передавать производную не нужно.
+// На отрезках, где фаза меняется мало (в том числе возле стационарных
+// точек ω' = 0), система Левина плохо обусловлена, и там используется
+// квадратура Клёншоу-Кёртиса по тем же точкам. Погрешность оценивается
+// сравнением 16 и 32 точек (вложенные сетки); отрезки с наибольшей
+// погрешностью делятся пополам, как в gauss_kronrod.h.
+
+namespace integration {
+
+// Результат: оба интеграла и общая оценка погрешности
+struct oscillatory_result {
+    double cosine;             // ∫ g(x) cos ω(x) dx
+    double sine;               // ∫ g(x) sin ω(x) dx
+    double error;              // оценка абсолютной погрешности (каждого из двух)
+    std::int64_t evaluations;  // число вычислений пары g(x), ω(x)
+    int segments;              // число отрезков в итоговом разбиении
+    bool converged;            // достигнута ли требуемая точность
+};
+
+namespace detail {
+
+// Отрезок с оценками обоих интегралов
+struct oscillatory_segment {
+    double a, b;
+    double cosine, sine;
+    double error;
+};
+
+// Точки Чебышёва-Лобатто и матрица дифференцирования на [-1, 1] для
+// n + 1 точек t_j = cos(pi j / n)
+struct chebyshev_lobatto {
+    explicit chebyshev_lobatto(int n) : n(n), t(n + 1), d((n + 1) * (n + 1), 0.0) {
+        const double pi = 4.0 * std::atan(1.0);
+        for (int j = 0; j <= n; j++) {
+            t[j] = std::cos(pi * j / n);
+        }
+        // Матрица дифференцирования (Трефетен, "Spectral methods in MATLAB");
+        // диагональ - минус сумма строки, что точнее явной формулы
+        for (int i = 0; i <= n; i++) {
+            double ci = (i == 0 || i == n) ? 2.0 : 1.0;
+            double diagonal = 0.0;
+            for (int j = 0; j <= n; j++) {
+                if (i == j) {
+                    continue;
+                }
+                double cj = (j == 0 || j == n) ? 2.0 : 1.0;
+                double sign = ((i + j) % 2 == 0) ? 1.0 : -1.0;
+                double value = ci / cj * sign / (t[i] - t[j]);
+                d[i * (n + 1) + j] = value;
+                diagonal -= value;
+            }
+            d[i * (n + 1) + i] = diagonal;
+        }
+        // Веса Клёншоу-Кёртиса: интеграл интерполянта по [-1, 1]
+        weights.assign(n + 1, 0.0);
+        for (int j = 0; j <= n; j++) {
+            double sum = 0.0;
+            for (int k = 0; k <= n; k += 2) {
+                double term = 2.0 / (1.0 - static_cast<double>(k) * k) * std::cos(pi * j * k / n);
+                sum += (k == 0 || k == n) ? 0.5 * term : term;
+            }
+            double scale = (j == 0 || j == n) ? 1.0 / n : 2.0 / n;
+            weights[j] = sum * scale;
+        }
+    }
+
+    int n;
+    std::vector<double> t;
+    std::vector<double> d;        // (n + 1) x (n + 1), по строкам
+    std::vector<double> weights;  // веса Клёншоу-Кёртиса
+};
+
+// Решение системы m x m методом Гаусса с выбором главного элемента;
+// false, если матрица вырождена
+inline bool solve_linear(std::vector<double>& matrix, std::vector<double>& rhs, int m) {
+    for (int column = 0; column < m; column++) {
+        int pivot = column;
+        for (int row = column + 1; row < m; row++) {
+            if (std::abs(matrix[row * m + column]) > std::abs(matrix[pivot * m + column])) {
+                pivot = row;
+            }
+        }
+        if (matrix[pivot * m + column] == 0.0) {
+            return false;
+        }
+        if (pivot != column) {
+            for (int k = column; k < m; k++) {
+                std::swap(matrix[pivot * m + k], matrix[column * m + k]);
+            }
+            std::swap(rhs[pivot], rhs[column]);
+        }
+        for (int row = column + 1; row < m; row++) {
+            double factor = matrix[row * m + column] / matrix[column * m + column];
+            if (factor == 0.0) {
+                continue;
+            }
+            for (int k = column; k < m; k++) {
+                matrix[row * m + k] -= factor * matrix[column * m + k];
+            }
+            rhs[row] -= factor * rhs[column];
+        }
+    }
+    for (int row = m - 1; row >= 0; row--) {
+        double sum = rhs[row];
+        for (int k = row + 1; k < m; k++) {
+            sum -= matrix[row * m + k] * rhs[k];
+        }
+        rhs[row] = sum / matrix[row * m + row];
+    }
+    return true;
+}
+
+// Оценка (C, S) на [a, b] по значениям g и ω в точках сетки grid;
+// stride - шаг по массивам значений (для вложенной сетки 16 из 32)
+inline std::pair<double, double> levin_panel(const chebyshev_lobatto& grid, double a, double b,
+                                             const double* g, const double* omega, int stride) {
+    const int n = grid.n;
+    const int points = n + 1;
+    const double half = 0.5 * (b - a);
+
+    // ω' в узлах: производная интерполянта ω
+    std::vector<double> derivative(points, 0.0);
+    double phase_rate = 0.0;
+    for (int i = 0; i < points; i++) {
+        double sum = 0.0;
+        for (int j = 0; j < points; j++) {
+            sum += grid.d[i * points + j] * omega[j * stride];
+        }
+        derivative[i] = sum / half;
+        phase_rate = std::max(phase_rate, std::abs(derivative[i]));
+    }
+
+    // Фаза меняется мало - квадратура Клёншоу-Кёртиса
+    if (phase_rate * half <= 0.25 * n) {
+        double c = 0.0, s = 0.0;
+        for (int j = 0; j < points; j++) {
+            double w = grid.weights[j] * g[j * stride];
+            c += w * std::cos(omega[j * stride]);
+            s += w * std::sin(omega[j * stride]);
+        }
+        return {c * half, s * half};
+    }
+
+    // Коллокация для p = u + i v:  u' - ω' v = g,  v' + ω' u = 0
+    const int m = 2 * points;
+    std::vector<double> matrix(static_cast<std::size_t>(m) * m, 0.0);
+    std::vector<double> rhs(m, 0.0);
+    for (int i = 0; i < points; i++) {
+        for (int j = 0; j < points; j++) {
+            double dij = grid.d[i * points + j] / half;
+            matrix[i * m + j] = dij;
+            matrix[(points + i) * m + points + j] = dij;
+        }
+        matrix[i * m + points + i] -= derivative[i];
+        matrix[(points + i) * m + i] += derivative[i];
+        rhs[i] = g[i * stride];
+    }
+    if (!solve_linear(matrix, rhs, m)) {
+        double nan = std::numeric_limits<double>::quiet_NaN();
+        return {nan, nan};
+    }
+    // t = 1 - правый конец (j = 0), t = -1 - левый (j = n)
+    auto boundary = [&](int j) {
+        double u = rhs[j], v = rhs[points + j];
+        double c = std::cos(omega[j * stride]), s = std::sin(omega[j * stride]);
+        return std::make_pair(u * c - v * s, u * s + v * c);
+    };
+    std::pair<double, double> right = boundary(0), left = boundary(n);
+    return {right.first - left.first, right.second - left.second};
+}
+
+} // namespace detail
+
+// C и S на [a, b]: g - амплитуда, omega - фаза (гладкие функции x).
+// Отрезки делятся, пока суммарная погрешность больше
+// max(abs_tol, rel_tol * |C + i S|) или пока их не станет max_segments.
+template <typename Amplitude, typename Phase>
+oscillatory_result levin(Amplitude g, Phase omega, double a, double b, double abs_tol,
+                         double rel_tol = 0.0, std::size_t max_segments = 1000) {
+    INTEGRATION_RULE_SCOPE("levin");
+    static const detail::chebyshev_lobatto coarse(16), fine(32);
+    std::int64_t evaluations = 0;
+
+    auto estimate = [&](double left, double right) {
+        double center = 0.5 * (left + right), half = 0.5 * (right - left);
+        double gv[33], wv[33];
+        for (int j = 0; j <= fine.n; j++) {
+            double x = center + half * fine.t[j];
+            gv[j] = g(x);
+            wv[j] = omega(x);
+        }
+        evaluations += fine.n + 1;
+        // Чётные точки 32-точечной сетки образуют 16-точечную
+        std::pair<double, double> high = detail::levin_panel(fine, left, right, gv, wv, 1);
+        std::pair<double, double> low = detail::levin_panel(coarse, left, right, gv, wv, 2);
+        double error = std::max(std::abs(high.first - low.first), std::abs(high.second - low.second));
+        if (!std::isfinite(high.first) || !std::isfinite(high.second)) {
+            error = std::numeric_limits<double>::infinity();
+        }
+        return detail::oscillatory_segment{left, right, high.first, high.second, error};
+    };
+
+    auto by_error = [](const detail::oscillatory_segment& x, const detail::oscillatory_segment& y) {
+        return x.error < y.error;
+    };
+    std::vector<detail::oscillatory_segment> heap;
+    heap.reserve(max_segments);
+    heap.push_back(estimate(a, b));
+    double cosine = heap[0].cosine, sine = heap[0].sine, error = heap[0].error;
+    bool converged = false;
+
+    for (;;) {
+        if (error <= std::max(abs_tol, rel_tol * std::hypot(cosine, sine))) {
+            // Пересчёт сумм перед остановкой, как в gauss_kronrod
+            cosine = sine = error = 0.0;
+            for (const detail::oscillatory_segment& segment : heap) {
+                cosine += segment.cosine;
+                sine += segment.sine;
+                error += segment.error;
+            }
+            if (error <= std::max(abs_tol, rel_tol * std::hypot(cosine, sine))) {
+                converged = true;
+                break;
+            }
+        }
+        if (heap.size() >= max_segments) {
+            break;
+        }
+        std::pop_heap(heap.begin(), heap.end(), by_error);
+        detail::oscillatory_segment worst = heap.back();
+        double middle = 0.5 * (worst.a + worst.b);
+        if (!(worst.a < middle && middle < worst.b)) {
+            std::push_heap(heap.begin(), heap.end(), by_error);
+            break;
+        }
+        detail::oscillatory_segment left = estimate(worst.a, middle);
+        detail::oscillatory_segment right = estimate(middle, worst.b);
+        cosine += left.cosine + right.cosine - worst.cosine;
+        sine += left.sine + right.sine - worst.sine;
+        error += left.error + right.error - worst.error;
+        if (!std::isfinite(error) || !std::isfinite(cosine) || !std::isfinite(sine)) {
+            // Неконечная оценка ушедшего отрезка дала inf - inf или NaN:
+            // суммы заново по оставшимся отрезкам (worst - последний в heap)
+            cosine = left.cosine + right.cosine;
+            sine = left.sine + right.sine;
+            error = left.error + right.error;
+            for (auto it = heap.begin(); it != heap.end() - 1; ++it) {
+                cosine += it->cosine;
+                sine += it->sine;
+                error += it->error;
+            }
+        }
+
+        heap.back() = left;
+        std::push_heap(heap.begin(), heap.end(), by_error);
+        heap.push_back(right);
+        std::push_heap(heap.begin(), heap.end(), by_error);
+    }
+
+    if (!converged) {
+        cosine = sine = error = 0.0;
+        for (const detail::oscillatory_segment& segment : heap) {
+            cosine += segment.cosine;
+            sine += segment.sine;
+            error += segment.error;
+        }
+    }
+    INTEGRATION_COUNT_EVALUATIONS(evaluations);
+    return {cosine, sine, error, evaluations, static_cast<int>(heap.size()), converged};
+}
+
+} // namespace integration
+
+#endif // OSCILLATORY_H
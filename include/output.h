@@ -0,0 +1,300 @@
+#ifndef OUTPUT_H
+#define OUTPUT_H
+
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <limits>
+#include <string>
+#include <utility>
+#include <vector>
+
+// Вывод таблиц результатов (строки таблиц сходимости и т.п.) без iostream.
+// Числа форматируются std::to_chars прямо в большой буфер, который
+// сбрасывается в FILE* целиком, а не после каждой строки. Форматы:
+//   table      - таблица для человека: столбцы фиксированной ширины
+//                (как setw), числа fixed или scientific с заданной точностью;
+//   csv        - заголовок и строки через запятую, кратчайшая запись
+//                double, которая читается обратно в то же число;
+//   json_lines - один объект {"столбец": значение, ...} в строке, NaN и
+//                бесконечности - null;
+//   binary     - заголовок "INTGROWS", версия (u32), число столбцов (u32),
+//                для каждого столбца вид (u8) и имя (u32 длина + байты);
+//                затем строки: по 8 байт на столбец (int64 для целых -
+//                с насыщением вне диапазона, NaN - 0; иначе double),
+//                порядок байтов машины.
+// Вывод в FILE*, общий с другими частями программы, сохраняет порядок, если
+// перед ними вызывается finish() (или writer разрушается).
+
+namespace integration {
+
+enum class output_format { table, csv, json_lines, binary };
+
+// "table", "csv", "jsonl" (или "json_lines"), "binary"
+inline bool parse_output_format(const std::string& name, output_format& format) {
+    if (name == "table") {
+        format = output_format::table;
+    } else if (name == "csv") {
+        format = output_format::csv;
+    } else if (name == "jsonl" || name == "json_lines") {
+        format = output_format::json_lines;
+    } else if (name == "binary") {
+        format = output_format::binary;
+    } else {
+        return false;
+    }
+    return true;
+}
+
+// Буфер поверх FILE*: запись в память, сброс при заполнении и в деструкторе
+class output_buffer {
+public:
+    explicit output_buffer(std::FILE* out, std::size_t capacity = 1 << 20)
+        : out_(out), data_(capacity) {}
+    ~output_buffer() { flush(); }
+
+    output_buffer(const output_buffer&) = delete;
+    output_buffer& operator=(const output_buffer&) = delete;
+
+    void write(const char* text, std::size_t size) {
+        if (size > data_.size() - used_) {
+            flush();
+            if (size > data_.size()) {
+                std::fwrite(text, 1, size, out_);
+                return;
+            }
+        }
+        std::memcpy(data_.data() + used_, text, size);
+        used_ += size;
+    }
+
+    void write(const std::string& text) { write(text.data(), text.size()); }
+    void put(char c) { write(&c, 1); }
+
+    // n символов c (выравнивание столбцов)
+    void fill(char c, std::size_t n) {
+        for (std::size_t i = 0; i < n; i++) {
+            put(c);
+        }
+    }
+
+    void flush() {
+        if (used_ > 0) {
+            std::fwrite(data_.data(), 1, used_, out_);
+            used_ = 0;
+        }
+        std::fflush(out_);
+    }
+
+private:
+    std::FILE* out_;
+    std::vector<char> data_;
+    std::size_t used_ = 0;
+};
+
+// Вид столбца: целые; fixed и scientific - как одноимённые манипуляторы
+// iostream (только для table, остальные форматы пишут кратчайшую запись)
+enum class column_style : std::uint8_t { integer, fixed, scientific };
+
+struct output_column {
+    std::string name;
+    column_style style = column_style::fixed;
+    int width = 0;       // ширина в table (в байтах, как setw)
+    int precision = 6;   // знаков после запятой в table
+};
+
+namespace detail {
+
+// Целые столбцы пишутся как int64, если значение в его диапазоне [-2^63, 2^63)
+inline bool fits_int64(double value) {
+    return value >= -0x1p63 && value < 0x1p63;
+}
+
+// Запись числа в text; возвращает длину. Буфера на 400 байт хватает для
+// fixed-записи любого double с точностью до 60 знаков
+inline std::size_t format_number(char* text, double value, column_style style, int precision,
+                                 bool shortest) {
+    char* end = text + 400;
+    std::to_chars_result result{};
+    if (style == column_style::integer && fits_int64(value)) {
+        result = std::to_chars(text, end, static_cast<long long>(value));
+    } else if (shortest || style == column_style::integer) {
+        // Целое вне диапазона int64 - кратчайшая запись double
+        result = std::to_chars(text, end, value);
+    } else {
+        result = std::to_chars(text, end, value,
+                               style == column_style::scientific ? std::chars_format::scientific
+                                                                 : std::chars_format::fixed,
+                               precision);
+    }
+    if (result.ec != std::errc()) {
+        return static_cast<std::size_t>(std::snprintf(text, 400, "%.17g", value));
+    }
+    return static_cast<std::size_t>(result.ptr - text);
+}
+
+} // namespace detail
+
+class table_writer {
+public:
+    table_writer(output_format format, std::vector<output_column> columns, std::FILE* out = stdout)
+        : format_(format), columns_(std::move(columns)), buffer_(out) {
+        header();
+    }
+    ~table_writer() { finish(); }
+
+    // Текст для NaN в table (по умолчанию "nan")
+    void set_nan_text(const std::string& text) { nan_text_ = text; }
+
+    // Одна строка: по значению на столбец
+    void row(std::initializer_list<double> values) { row(values.begin(), values.size()); }
+
+    void row(const double* values, std::size_t count) {
+        switch (format_) {
+        case output_format::table: table_row(values, count); break;
+        case output_format::csv: csv_row(values, count); break;
+        case output_format::json_lines: json_row(values, count); break;
+        case output_format::binary: binary_row(values, count); break;
+        }
+    }
+
+    // Сбросить буфер (перед выводом в тот же FILE* другими средствами)
+    void finish() { buffer_.flush(); }
+
+private:
+    void header() {
+        switch (format_) {
+        case output_format::table: {
+            std::size_t total = 0;
+            for (std::size_t i = 0; i < columns_.size(); i++) {
+                if (i > 0) {
+                    buffer_.put(' ');
+                    total++;
+                }
+                pad(columns_[i].name.size(), columns_[i].width);
+                buffer_.write(columns_[i].name);
+                total += static_cast<std::size_t>(columns_[i].width);
+            }
+            buffer_.put('\n');
+            buffer_.fill('-', total);
+            buffer_.put('\n');
+            break;
+        }
+        case output_format::csv:
+            for (std::size_t i = 0; i < columns_.size(); i++) {
+                if (i > 0) {
+                    buffer_.put(',');
+                }
+                buffer_.write(columns_[i].name);
+            }
+            buffer_.put('\n');
+            break;
+        case output_format::json_lines:
+            break;
+        case output_format::binary: {
+            buffer_.write("INTGROWS", 8);
+            write_raw(static_cast<std::uint32_t>(1));
+            write_raw(static_cast<std::uint32_t>(columns_.size()));
+            for (const output_column& column : columns_) {
+                write_raw(static_cast<std::uint8_t>(column.style));
+                write_raw(static_cast<std::uint32_t>(column.name.size()));
+                buffer_.write(column.name);
+            }
+            break;
+        }
+        }
+    }
+
+    void pad(std::size_t length, int width) {
+        if (static_cast<std::size_t>(width) > length) {
+            buffer_.fill(' ', static_cast<std::size_t>(width) - length);
+        }
+    }
+
+    void table_row(const double* values, std::size_t count) {
+        char text[400];
+        for (std::size_t i = 0; i < count && i < columns_.size(); i++) {
+            const output_column& column = columns_[i];
+            if (i > 0) {
+                buffer_.put(' ');
+            }
+            if (std::isnan(values[i]) && !nan_text_.empty()) {
+                pad(nan_text_.size(), column.width);
+                buffer_.write(nan_text_);
+                continue;
+            }
+            std::size_t length = detail::format_number(text, values[i], column.style,
+                                                       column.precision, false);
+            pad(length, column.width);
+            buffer_.write(text, length);
+        }
+        buffer_.put('\n');
+    }
+
+    void csv_row(const double* values, std::size_t count) {
+        char text[400];
+        for (std::size_t i = 0; i < count && i < columns_.size(); i++) {
+            if (i > 0) {
+                buffer_.put(',');
+            }
+            buffer_.write(text, detail::format_number(text, values[i], columns_[i].style, 0, true));
+        }
+        buffer_.put('\n');
+    }
+
+    void json_row(const double* values, std::size_t count) {
+        char text[400];
+        buffer_.put('{');
+        for (std::size_t i = 0; i < count && i < columns_.size(); i++) {
+            buffer_.write(i > 0 ? ", \"" : "\"", i > 0 ? 3 : 1);
+            buffer_.write(columns_[i].name);
+            buffer_.write("\": ", 3);
+            if (std::isfinite(values[i])) {
+                buffer_.write(text,
+                              detail::format_number(text, values[i], columns_[i].style, 0, true));
+            } else {
+                buffer_.write("null", 4);
+            }
+        }
+        buffer_.write("}\n", 2);
+    }
+
+    void binary_row(const double* values, std::size_t count) {
+        for (std::size_t i = 0; i < columns_.size(); i++) {
+            double value = i < count ? values[i] : std::nan("");
+            if (columns_[i].style == column_style::integer) {
+                // Вне диапазона int64 - насыщение, NaN - 0
+                std::int64_t integer = 0;
+                if (detail::fits_int64(value)) {
+                    integer = static_cast<std::int64_t>(value);
+                } else if (value > 0.0) {
+                    integer = std::numeric_limits<std::int64_t>::max();
+                } else if (value < 0.0) {
+                    integer = std::numeric_limits<std::int64_t>::min();
+                }
+                write_raw(integer);
+            } else {
+                write_raw(value);
+            }
+        }
+    }
+
+    template <typename T>
+    void write_raw(T value) {
+        char bytes[sizeof(T)];
+        std::memcpy(bytes, &value, sizeof(T));
+        buffer_.write(bytes, sizeof(T));
+    }
+
+    output_format format_;
+    std::vector<output_column> columns_;
+    output_buffer buffer_;
+    std::string nan_text_;
+};
+
+} // namespace integration
+
+#endif // OUTPUT_H
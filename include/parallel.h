@@ -0,0 +1,96 @@
+#ifndef PARALLEL_H
+#define PARALLEL_H
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+#include "integration.h"
+#include "thread_pool.h"
+
+// Параллельная политика выполнения для правил из integration.h:
+//   integration::trapezoid(f, a, b, n, integration::parallel_execution());
+// Узлы делятся на порции, порции выполняются в пуле с перехватом работы.
+// Пока узлов меньше двух порций, всё считается в вызывающем потоке.
+// Разбиение на порции и порядок сложения частичных сумм не зависят от
+// числа потоков, поэтому и в быстром режиме результат при любом числе
+// потоков одинаков. В режиме summation_mode::reproducible каждая порция
+// набирает точную сумму, и результат совпадает до бита ещё и с
+// sequential_execution в том же режиме.
+
+namespace integration {
+
+struct parallel_execution {
+    thread_pool* pool = nullptr;       // nullptr - общий пул default_pool()
+    std::int64_t grain = 1 << 15;      // минимальное число узлов в одной порции
+    std::int64_t max_chunks = 1024;    // верхняя граница числа порций
+    summation_mode mode = summation_mode::fast;
+
+    parallel_execution() = default;
+    explicit parallel_execution(summation_mode m) : mode(m) {}
+    explicit parallel_execution(thread_pool& p, std::int64_t g = 1 << 15,
+                                summation_mode m = summation_mode::fast)
+        : pool(&p), grain(g), mode(m) {}
+
+    template <typename Function>
+    detail::value_type<Function> sum_nodes(Function& f, double start, double step, double offset,
+                                           int first, int last, int stride = 1) const {
+        using value_type = detail::value_type<Function>;
+        std::int64_t count = detail::node_count(first, last, stride);
+        thread_pool& workers = pool ? *pool : default_pool();
+        if (count < 2 * grain) {
+            return sequential_execution{mode}.sum_nodes(f, start, step, offset, first, last, stride);
+        }
+        INTEGRATION_COUNT_EVALUATIONS(count);
+
+        // Размер порции зависит только от числа узлов, а не от числа потоков.
+        // В пуле из одного потока порции считаются по очереди в вызывающем
+        // потоке - те же частичные суммы, что и при нескольких потоках.
+        std::int64_t chunk = std::max(grain, (count + max_chunks - 1) / max_chunks);
+        std::int64_t chunks = (count + chunk - 1) / chunk;
+        auto for_each_chunk = [&](auto&& body) {
+            if (workers.size() == 1) {
+                for (std::int64_t c = 0; c < chunks; c++) {
+                    body(c);
+                }
+            } else {
+                parallel_for(workers, chunks, body);
+            }
+        };
+
+        if (mode == summation_mode::reproducible) {
+            std::vector<exact_accumulator<value_type>> exact(static_cast<std::size_t>(chunks));
+            for_each_chunk([&](std::int64_t c) {
+                std::int64_t begin = first + c * chunk * stride;
+                std::int64_t end = std::min<std::int64_t>(last, begin + chunk * stride);
+                detail::sum_nodes_exact(f, start, step, offset, static_cast<int>(begin),
+                                        static_cast<int>(end), stride,
+                                        exact[static_cast<std::size_t>(c)]);
+            });
+            exact_accumulator<value_type> total;
+            for (const exact_accumulator<value_type>& part : exact) {
+                total.add(part);
+            }
+            return total.value();
+        }
+
+        std::vector<value_type> partial(static_cast<std::size_t>(chunks));
+        for_each_chunk([&](std::int64_t c) {
+            std::int64_t begin = first + c * chunk * stride;
+            std::int64_t end = std::min<std::int64_t>(last, begin + chunk * stride);
+            partial[static_cast<std::size_t>(c)] = detail::sum_nodes(
+                f, start, step, offset, static_cast<int>(begin), static_cast<int>(end), stride);
+        });
+
+        // Частичные суммы складываются в фиксированном порядке
+        value_type total = 0.0;
+        for (const value_type& value : partial) {
+            total += value;
+        }
+        return total;
+    }
+};
+
+} // namespace integration
+
+#endif // PARALLEL_H
@@ -0,0 +1,205 @@
+#ifndef PARTIAL_FRACTIONS_H
+#define PARTIAL_FRACTIONS_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+#include "polynomial.h"
+#include "rational.h"
+
+// Точная первообразная рациональной функции через разложение на простейшие
+// дроби:
+//   P/Q = S(x) + sum_k sum_{j=1..m_k} A_kj / (x - r_k)^j
+// где S - целая часть, r_k - корни Q (вещественные и комплексно
+// сопряжённые пары) кратности m_k. Первообразная слагаемых:
+//   j = 1:  A ln|x - r| для вещественного r, 2 Re[A log(x - r)] для пары
+//   j > 1:  -A / ((j - 1) (x - r)^(j-1)) (для пары - удвоенная вещественная часть)
+// У пары берётся корень с Im r > 0: тогда x - r при вещественном x не пересекает
+// разрез логарифма и первообразная непрерывна. Разложение строится один раз,
+// значение F(x) вычисляется за O(степени), без квадратуры.
+
+namespace integration {
+
+namespace detail {
+
+// Первые count коэффициентов ряда Тейлора многочлена в точке r
+// (повторное деление на (x - r) по схеме Горнера)
+inline std::vector<std::complex<double>> taylor_coefficients(const std::vector<double>& coefficients,
+                                                             std::complex<double> r, int count) {
+    std::vector<std::complex<double>> b(coefficients.begin(), coefficients.end());
+    std::vector<std::complex<double>> result(count, 0.0);
+    for (int k = 0; k < count && !b.empty(); k++) {
+        std::complex<double> carry = 0.0;
+        for (std::size_t i = b.size(); i-- > 0;) {
+            std::complex<double> next = b[i] + carry * r;
+            b[i] = carry;
+            carry = next;
+        }
+        result[k] = carry;
+        b.pop_back();
+    }
+    return result;
+}
+
+} // namespace detail
+
+class partial_fractions {
+public:
+    // Слагаемое A / (x - root)^power; для комплексного root (Im > 0)
+    // подразумевается и сопряжённое слагаемое
+    struct term {
+        std::complex<double> root;
+        int power;
+        std::complex<double> coefficient;
+    };
+
+    explicit partial_fractions(const rational& f) {
+        using complex = std::complex<double>;
+        std::vector<double> remainder;
+        polynomial_divide(f.numerator(), f.denominator(), polynomial_, remainder);
+        const std::vector<double>& denominator = f.denominator();
+        if (denominator.empty()) {
+            return;
+        }
+        const double leading = denominator.back();
+        std::vector<polynomial_root> roots = polynomial_root_clusters(denominator);
+        std::vector<double> magnitudes(remainder.size());
+        for (std::size_t i = 0; i < remainder.size(); i++) {
+            magnitudes[i] = std::abs(remainder[i]);
+        }
+
+        const double epsilon = std::numeric_limits<double>::epsilon();
+        for (std::size_t k = 0; k < roots.size(); k++) {
+            const complex r = roots[k].value;
+            const int m = roots[k].multiplicity;
+            if (r.imag() < 0.0) {
+                continue; // сопряжённый корень учитывается вместе с парой
+            }
+            // Q(x) = (x - r)^m g(x); ряды Тейлора g и остатка R в точке r до t^(m-1)
+            std::vector<complex> g(m, 0.0);
+            g[0] = leading;
+            for (std::size_t j = 0; j < roots.size(); j++) {
+                if (j == k) {
+                    continue;
+                }
+                const complex shift = r - roots[j].value;
+                for (int p = 0; p < roots[j].multiplicity; p++) {
+                    // умножение ряда на (shift + t)
+                    for (int i = m - 1; i > 0; i--) {
+                        g[i] = g[i] * shift + g[i - 1];
+                    }
+                    g[0] *= shift;
+                }
+            }
+            std::vector<complex> numerator = detail::taylor_coefficients(remainder, r, m);
+            // Те же ряды по модулям коэффициентов - масштаб ошибки округления
+            std::vector<complex> bound =
+                detail::taylor_coefficients(magnitudes, std::abs(r), m);
+
+            // Коэффициент при 1/(x - r)^(m - i) - i-й член ряда R/g
+            std::vector<complex> h(m);
+            std::vector<double> size(m);
+            for (int i = 0; i < m; i++) {
+                complex sum = numerator[i];
+                double magnitude = bound[i].real();
+                for (int l = 1; l <= i; l++) {
+                    sum -= g[l] * h[i - l];
+                    magnitude += std::abs(g[l]) * size[i - l];
+                }
+                h[i] = sum / g[0];
+                size[i] = magnitude / std::abs(g[0]);
+            }
+            for (int i = 0; i < m; i++) {
+                // Коэффициент на уровне своей ошибки сокращения - следствие
+                // общего корня числителя и знаменателя (устранимый разрыв)
+                if (std::abs(h[i]) <= 64.0 * epsilon * size[i]) {
+                    continue;
+                }
+                complex coefficient = r.imag() == 0.0 ? complex(h[i].real(), 0.0) : h[i];
+                terms_.push_back({r, m - i, coefficient});
+            }
+        }
+
+        for (const term& t : terms_) {
+            if (t.root.imag() == 0.0 &&
+                std::find(poles_.begin(), poles_.end(), t.root.real()) == poles_.end()) {
+                poles_.push_back(t.root.real());
+            }
+        }
+        std::sort(poles_.begin(), poles_.end());
+
+        // Первообразная целой части
+        integral_polynomial_.assign(polynomial_.size() + 1, 0.0);
+        for (std::size_t i = 0; i < polynomial_.size(); i++) {
+            integral_polynomial_[i + 1] = polynomial_[i] / static_cast<double>(i + 1);
+        }
+    }
+
+    // Первообразная F(x) (в полюсе - бесконечность)
+    double operator()(double x) const {
+        double result = polynomial_value(integral_polynomial_, x);
+        for (const term& t : terms_) {
+            if (t.root.imag() == 0.0) {
+                double distance = x - t.root.real();
+                double a = t.coefficient.real();
+                result += t.power == 1 ? a * std::log(std::abs(distance))
+                                       : -a / ((t.power - 1) * std::pow(distance, t.power - 1));
+            } else {
+                std::complex<double> distance = x - t.root;
+                std::complex<double> value =
+                    t.power == 1 ? t.coefficient * std::log(distance)
+                                 : -t.coefficient / (static_cast<double>(t.power - 1) *
+                                                     std::pow(distance, t.power - 1));
+                result += 2.0 * value.real();
+            }
+        }
+        return result;
+    }
+
+    // Определённый интеграл; если на [a, b] есть полюс - он расходится (inf)
+    double integral(double a, double b) const {
+        for (double pole : poles_) {
+            if (pole >= std::min(a, b) && pole <= std::max(a, b)) {
+                return std::numeric_limits<double>::infinity();
+            }
+        }
+        return (*this)(b) - (*this)(a);
+    }
+
+    // Главное значение по Коши. Вклады ln|x - r| и 1/(x - r)^(2k) в F чётны
+    // относительно полюса и сокращаются в симметричном пределе; слагаемые
+    // 1/(x - r)^(2k) в f дают бесконечность, и главного значения нет (inf),
+    // как и для полюса на конце отрезка.
+    double principal_value(double a, double b) const {
+        const double low = std::min(a, b), high = std::max(a, b);
+        for (const term& t : terms_) {
+            if (t.root.imag() != 0.0) {
+                continue;
+            }
+            double pole = t.root.real();
+            if (pole == low || pole == high ||
+                (pole > low && pole < high && t.power % 2 == 0)) {
+                return std::numeric_limits<double>::infinity();
+            }
+        }
+        return (*this)(b) - (*this)(a);
+    }
+
+    const std::vector<double>& polynomial() const { return polynomial_; }
+    const std::vector<term>& terms() const { return terms_; }
+    const std::vector<double>& poles() const { return poles_; }
+
+private:
+    std::vector<double> polynomial_;          // целая часть S
+    std::vector<double> integral_polynomial_; // её первообразная
+    std::vector<term> terms_;                 // простейшие дроби
+    std::vector<double> poles_;               // вещественные полюса по возрастанию
+};
+
+} // namespace integration
+
+#endif // PARTIAL_FRACTIONS_H
@@ -0,0 +1,282 @@
+#ifndef POLYNOMIAL_H
+#define POLYNOMIAL_H
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <cstddef>
+#include <limits>
+#include <vector>
+
+// Многочлены, заданные массивом коэффициентов по возрастанию степеней:
+// {c0, c1, ..., cn} означает c0 + c1 x + ... + cn x^n.
+// Корни ищутся итерациями Аберта (Ehrlich-Aberth): все n корней уточняются
+// одновременно, каждый отталкивается от остальных, поэтому сходимость
+// кубическая для простых корней и не зависит от удачного начального
+// приближения. Кратные корни сходятся медленнее и с точностью ~eps^(1/m),
+// поэтому корни, неотличимые с такой точностью, затем объединяются в один.
+
+namespace integration {
+
+// Значение многочлена по схеме Горнера
+template <typename Value>
+Value polynomial_value(const std::vector<double>& coefficients, Value x) {
+    Value result = 0.0;
+    for (std::size_t i = coefficients.size(); i-- > 0;) {
+        result = result * x + coefficients[i];
+    }
+    return result;
+}
+
+// Коэффициенты производной
+inline std::vector<double> polynomial_derivative(const std::vector<double>& coefficients) {
+    std::vector<double> result;
+    for (std::size_t i = 1; i < coefficients.size(); i++) {
+        result.push_back(static_cast<double>(i) * coefficients[i]);
+    }
+    return result;
+}
+
+// Отбросить нулевые старшие коэффициенты
+inline std::vector<double> polynomial_trim(std::vector<double> coefficients) {
+    while (!coefficients.empty() && coefficients.back() == 0.0) {
+        coefficients.pop_back();
+    }
+    return coefficients;
+}
+
+// Деление с остатком: numerator = quotient * denominator + remainder,
+// степень остатка меньше степени делителя
+inline void polynomial_divide(std::vector<double> numerator, std::vector<double> denominator,
+                              std::vector<double>& quotient, std::vector<double>& remainder) {
+    numerator = polynomial_trim(std::move(numerator));
+    denominator = polynomial_trim(std::move(denominator));
+    quotient.clear();
+    if (denominator.empty() || numerator.size() < denominator.size()) {
+        remainder = numerator;
+        return;
+    }
+    const std::size_t shift = numerator.size() - denominator.size();
+    quotient.assign(shift + 1, 0.0);
+    for (std::size_t k = shift + 1; k-- > 0;) {
+        double factor = numerator[k + denominator.size() - 1] / denominator.back();
+        quotient[k] = factor;
+        for (std::size_t i = 0; i < denominator.size(); i++) {
+            numerator[k + i] -= factor * denominator[i];
+        }
+    }
+    numerator.resize(denominator.size() - 1);
+    remainder = polynomial_trim(std::move(numerator));
+}
+
+// Все комплексные корни многочлена с учётом кратности (нулевой многочлен
+// и константы корней не имеют)
+inline std::vector<std::complex<double>> polynomial_roots(std::vector<double> coefficients,
+                                                          int max_iterations = 500) {
+    using complex = std::complex<double>;
+    coefficients = polynomial_trim(std::move(coefficients));
+    std::vector<complex> roots;
+
+    // Нулевые младшие коэффициенты - корни x = 0
+    std::size_t zeros = 0;
+    while (zeros + 1 < coefficients.size() && coefficients[zeros] == 0.0) {
+        zeros++;
+    }
+    roots.assign(zeros, complex(0.0, 0.0));
+    coefficients.erase(coefficients.begin(), coefficients.begin() + zeros);
+    if (coefficients.size() < 2) {
+        return roots;
+    }
+
+    // Приводим к старшему коэффициенту 1
+    const std::size_t n = coefficients.size() - 1;
+    const double leading = coefficients[n];
+    for (double& c : coefficients) {
+        c /= leading;
+    }
+    if (n == 1) {
+        roots.push_back(-coefficients[0]);
+        return roots;
+    }
+    std::vector<double> derivative = polynomial_derivative(coefficients);
+
+    // Начальные приближения на окружности радиуса, оценивающего модули корней
+    // (граница Фудзивары, делённая пополам), с поворотом против симметрии
+    double radius = 0.0;
+    for (std::size_t i = 0; i < n; i++) {
+        radius = std::max(radius, std::pow(std::abs(coefficients[i]), 1.0 / (n - i)));
+    }
+    radius = radius > 0.0 ? radius : 1.0;
+    const double pi = 4.0 * std::atan(1.0);
+    std::vector<complex> z(n);
+    for (std::size_t k = 0; k < n; k++) {
+        z[k] = std::polar(radius, 2.0 * pi * k / n + 0.4);
+    }
+
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    for (int iteration = 0; iteration < max_iterations; iteration++) {
+        bool converged = true;
+        for (std::size_t k = 0; k < n; k++) {
+            complex p = polynomial_value(coefficients, z[k]);
+            if (p == 0.0) {
+                continue;
+            }
+            complex ratio = p / polynomial_value(derivative, z[k]);
+            complex repulsion = 0.0;
+            for (std::size_t j = 0; j < n; j++) {
+                if (j != k) {
+                    repulsion += 1.0 / (z[k] - z[j]);
+                }
+            }
+            complex correction = ratio / (1.0 - ratio * repulsion);
+            if (!std::isfinite(correction.real()) || !std::isfinite(correction.imag())) {
+                continue;
+            }
+            z[k] -= correction;
+            if (std::abs(correction) > 4.0 * epsilon * std::max(1.0, std::abs(z[k]))) {
+                converged = false;
+            }
+        }
+        if (converged) {
+            break;
+        }
+    }
+    roots.insert(roots.end(), z.begin(), z.end());
+    return roots;
+}
+
+// Корень вместе с кратностью
+struct polynomial_root {
+    std::complex<double> value;
+    int multiplicity;
+};
+
+namespace detail {
+
+// Радиус, на который ошибки округления Q сдвигают корень кратности m в
+// точке c: сдвиг d с |Q^(m)(c)/m!| d^m = eps * sum |a_i| |c|^i. Корни
+// дальше друг от друга (или от сопряжённых) - различные.
+inline double root_uncertainty(const std::vector<double>& coefficients, std::complex<double> c,
+                               int m) {
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    double magnitude = 0.0;
+    for (std::size_t i = coefficients.size(); i-- > 0;) {
+        magnitude = magnitude * std::abs(c) + std::abs(coefficients[i]);
+    }
+    std::vector<double> derivative = coefficients;
+    double factorial = 1.0;
+    for (int k = 1; k <= m; k++) {
+        derivative = polynomial_derivative(derivative);
+        factorial *= k;
+    }
+    double leading = std::abs(polynomial_value(derivative, c)) / factorial;
+    // Запас 4n: ошибка схемы Горнера и округление самих коэффициентов
+    double noise = 4.0 * static_cast<double>(coefficients.size()) * epsilon * magnitude;
+    if (leading == 0.0) {
+        return noise == 0.0 ? 0.0 : std::numeric_limits<double>::infinity();
+    }
+    return std::pow(noise / leading, 1.0 / m);
+}
+
+} // namespace detail
+
+// Различные корни с кратностями. Корень кратности m находится с точностью
+// ~eps^(1/m): m близких найденных корней объединяются в один, только если
+// их разброс не больше сдвига от ошибок округления для корня кратности m
+// (detail::root_uncertainty), то есть различить их нельзя. Так же мнимая
+// часть обнуляется, только если корень неотличим от сопряжённого.
+inline std::vector<polynomial_root> polynomial_root_clusters(const std::vector<double>& coefficients) {
+    using complex = std::complex<double>;
+    // Кандидаты в одно скопление - не дальше eps^(1/4) (кратности до 4 и выше)
+    const double candidate = 1e-3;
+    std::vector<complex> roots = polynomial_roots(coefficients);
+    std::sort(roots.begin(), roots.end(), [](const complex& x, const complex& y) {
+        return x.real() < y.real() || (x.real() == y.real() && x.imag() < y.imag());
+    });
+
+    std::vector<polynomial_root> result;
+    std::vector<bool> used(roots.size(), false);
+    for (std::size_t i = 0; i < roots.size(); i++) {
+        if (used[i]) {
+            continue;
+        }
+        // Соседи по возрастанию расстояния; берём наибольшее скопление,
+        // разброс которого объясняется округлением
+        std::vector<std::size_t> near{i};
+        for (std::size_t j = i + 1; j < roots.size(); j++) {
+            if (!used[j] &&
+                std::abs(roots[j] - roots[i]) <= candidate * std::max(1.0, std::abs(roots[i]))) {
+                near.push_back(j);
+            }
+        }
+        std::sort(near.begin() + 1, near.end(), [&](std::size_t x, std::size_t y) {
+            return std::abs(roots[x] - roots[i]) < std::abs(roots[y] - roots[i]);
+        });
+        complex value = roots[i];
+        std::size_t count = near.size();
+        for (; count > 1; count--) {
+            complex sum = 0.0;
+            for (std::size_t j = 0; j < count; j++) {
+                sum += roots[near[j]];
+            }
+            complex mean = sum / static_cast<double>(count);
+            double spread = 0.0;
+            for (std::size_t j = 0; j < count; j++) {
+                spread = std::max(spread, std::abs(roots[near[j]] - mean));
+            }
+            if (spread <= detail::root_uncertainty(coefficients, mean, static_cast<int>(count))) {
+                value = mean;
+                break;
+            }
+        }
+        for (std::size_t j = 0; j < count; j++) {
+            used[near[j]] = true;
+        }
+        const int multiplicity = static_cast<int>(count);
+        if (std::abs(value.imag()) <=
+            detail::root_uncertainty(coefficients, value, multiplicity)) {
+            value.imag(0.0);
+        }
+        result.push_back({value, multiplicity});
+    }
+
+    // Уточняем методом Ньютона; корень кратности m - простой корень
+    // (m-1)-й производной
+    for (polynomial_root& root : result) {
+        std::vector<double> target = coefficients;
+        for (int k = 1; k < root.multiplicity; k++) {
+            target = polynomial_derivative(target);
+        }
+        std::vector<double> slope = polynomial_derivative(target);
+        for (int iteration = 0; iteration < 3; iteration++) {
+            complex value = polynomial_value(target, root.value);
+            complex derivative = polynomial_value(slope, root.value);
+            if (value == 0.0 || derivative == 0.0) {
+                break;
+            }
+            root.value -= value / derivative;
+        }
+    }
+    return result;
+}
+
+// Вещественный корень вместе с кратностью
+struct real_root {
+    double value;
+    int multiplicity;
+};
+
+// Вещественные корни по возрастанию
+inline std::vector<real_root> polynomial_real_roots(const std::vector<double>& coefficients) {
+    std::vector<real_root> result;
+    for (const polynomial_root& root : polynomial_root_clusters(coefficients)) {
+        if (root.value.imag() == 0.0) {
+            result.push_back({root.value.real(), root.multiplicity});
+        }
+    }
+    return result;
+}
+
+} // namespace integration
+
+#endif // POLYNOMIAL_H
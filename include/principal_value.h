@@ -0,0 +1,158 @@
+#ifndef PRINCIPAL_VALUE_H
+#define PRINCIPAL_VALUE_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "gauss_kronrod.h"
+#include "gauss_legendre.h"
+#include "instrumentation.h"
+
+// Главное значение по Коши для простых полюсов внутри отрезка.
+// Вокруг полюса c берётся симметричный отрезок [c - r, c + r], на котором
+// работает квадратура Гаусса-Лежандра чётного порядка: её узлы идут
+// симметричными парами c ± t, и в сумме пары слагаемые вида res/(x - c)
+// взаимно уничтожаются:
+//   PV ∫[c-r, c+r] f(x) dx = ∫[0, r] (f(c + t) + f(c - t)) dt
+// Справа стоит гладкая функция, поэтому не нужны ни epsilon, ни вычет,
+// а точность растёт экспоненциально с порядком (16, 32, 64). Остаток
+// отрезка полюса не содержит и считается адаптивным Гауссом-Кронродом.
+// Для f = g(x)/(x - c) с гладким g машинная точность достигается за
+// несколько десятков вычислений функции.
+
+namespace integration {
+
+namespace detail {
+
+// Сложить результаты по частям отрезка
+inline void accumulate(adaptive_result& total, const adaptive_result& part) {
+    total.value += part.value;
+    total.error += part.error;
+    total.evaluations += part.evaluations;
+    total.segments += part.segments;
+    total.converged = total.converged && part.converged;
+}
+
+// PV на [c - r, c + r] парами узлов Гаусса-Лежандра порядка order;
+// magnitude - сумма модулей слагаемых (масштаб ошибки округления)
+template <typename Function>
+double symmetric_gauss(Function& f, double c, double r, int order, double& magnitude) {
+    gauss_legendre_view rule = gauss_legendre_rule(order);
+    INTEGRATION_COUNT_EVALUATIONS(order / 2 * 2);
+    double sum = 0.0;
+    magnitude = 0.0;
+    for (int k = 0; k < order / 2; k++) {
+        double t = r * rule.nodes[order - 1 - k];
+        double right = f(c + t);
+        double left = f(c - t);
+        sum += rule.weights[k] * (right + left);
+        magnitude += rule.weights[k] * (std::abs(right) + std::abs(left));
+    }
+    magnitude *= r;
+    return sum * r;
+}
+
+} // namespace detail
+
+// Главное значение на [a, b] с одним простым полюсом singularity;
+// остаток отрезка считается в рабочей памяти workspace
+template <typename Function>
+adaptive_result principal_value(Function f, double a, double b, double singularity,
+                                double abs_tol, double rel_tol,
+                                gauss_kronrod_workspace& workspace) {
+    INTEGRATION_RULE_SCOPE("principal_value");
+    // Полюс вне отрезка или на его конце - обычный интеграл
+    if (!(singularity > a && singularity < b)) {
+        return gauss_kronrod(f, a, b, abs_tol, rel_tol, workspace);
+    }
+
+    const double c = singularity;
+    const double epsilon = std::numeric_limits<double>::epsilon();
+    double radius = std::min(c - a, b - c);
+
+    // Порядки 16, 32, 64; если и 64 мало - уменьшаем симметричную часть вдвое,
+    // пока это уменьшает оценку погрешности (у самого полюса растёт ошибка
+    // округления в f, и дальше уменьшать бессмысленно)
+    double best_radius = radius;
+    adaptive_result best{0.0, std::numeric_limits<double>::infinity(), 0, 1, false};
+    std::int64_t evaluations = 0;
+    for (int attempt = 0; attempt < 30; attempt++) {
+        adaptive_result current{0.0, 0.0, 0, 1, false};
+        double magnitude = 0.0;
+        double previous = detail::symmetric_gauss(f, c, radius, 16, magnitude);
+        evaluations += 16;
+        for (int order = 32; order <= gauss_legendre_max_order; order *= 2) {
+            current.value = detail::symmetric_gauss(f, c, radius, order, magnitude);
+            current.error = std::abs(current.value - previous);
+            evaluations += order;
+            double tolerance = std::max({abs_tol, rel_tol * std::abs(current.value),
+                                         64.0 * epsilon * magnitude});
+            if (current.error <= tolerance) {
+                current.converged = true;
+                break;
+            }
+            previous = current.value;
+        }
+        if (!(current.error < best.error)) {
+            break;
+        }
+        best = current;
+        best_radius = radius;
+        if (current.converged) {
+            break;
+        }
+        radius *= 0.5;
+    }
+    radius = best_radius;
+    adaptive_result total = best;
+    total.evaluations = evaluations;
+
+    // Остаток отрезка по одну сторону от симметричной части
+    if (c - radius > a) {
+        detail::accumulate(total, gauss_kronrod(f, a, c - radius, abs_tol, rel_tol, workspace));
+    }
+    if (c + radius < b) {
+        detail::accumulate(total, gauss_kronrod(f, c + radius, b, abs_tol, rel_tol, workspace));
+    }
+    return total;
+}
+
+// Вариант с собственной рабочей памятью
+template <typename Function>
+adaptive_result principal_value(Function f, double a, double b, double singularity,
+                                double abs_tol = 1e-14, double rel_tol = 1e-14) {
+    gauss_kronrod_workspace workspace;
+    return principal_value(std::move(f), a, b, singularity, abs_tol, rel_tol, workspace);
+}
+
+// Главное значение на [a, b] с несколькими простыми полюсами:
+// отрезок делится посередине между соседними полюсами
+template <typename Function>
+adaptive_result principal_value(Function f, double a, double b, std::vector<double> poles,
+                                double abs_tol = 1e-14, double rel_tol = 1e-14) {
+    poles.erase(std::remove_if(poles.begin(), poles.end(),
+                               [a, b](double p) { return !(p > a && p < b); }),
+                poles.end());
+    std::sort(poles.begin(), poles.end());
+    poles.erase(std::unique(poles.begin(), poles.end()), poles.end());
+    if (poles.empty()) {
+        return gauss_kronrod(f, a, b, abs_tol, rel_tol);
+    }
+
+    adaptive_result total{0.0, 0.0, 0, 0, true};
+    double left = a;
+    for (std::size_t i = 0; i < poles.size(); i++) {
+        double right = (i + 1 < poles.size()) ? 0.5 * (poles[i] + poles[i + 1]) : b;
+        detail::accumulate(total, principal_value(f, left, right, poles[i], abs_tol, rel_tol));
+        left = right;
+    }
+    return total;
+}
+
+} // namespace integration
+
+#endif // PRINCIPAL_VALUE_H
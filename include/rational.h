@@ -0,0 +1,112 @@
+#ifndef RATIONAL_H
+#define RATIONAL_H
+
+#include <algorithm>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "polynomial.h"
+
+// Рациональная подынтегральная функция P(x)/Q(x), заданная массивами
+// коэффициентов (по возрастанию степеней, как в polynomial.h).
+// Вещественные полюса - корни знаменателя - находятся один раз при создании
+// объекта и хранятся вместе с ним, поэтому их не нужно вводить вручную.
+// Любой функтор с методом poles() (отсортированные точки разрыва) можно
+// передать в breakpoints/piecewise: отрезок будет разбит по полюсам, и
+// каждое правило интегрирования работает на частях без разрывов внутри.
+
+namespace integration {
+
+class rational {
+public:
+    rational(std::vector<double> numerator, std::vector<double> denominator)
+        : numerator_(polynomial_trim(std::move(numerator))),
+          denominator_(polynomial_trim(std::move(denominator))) {
+        for (const real_root& root : polynomial_real_roots(denominator_)) {
+            poles_.push_back(root.value);
+            multiplicities_.push_back(root.multiplicity);
+        }
+    }
+
+    double operator()(double x) const {
+        return polynomial_value(numerator_, x) / polynomial_value(denominator_, x);
+    }
+
+    const std::vector<double>& numerator() const { return numerator_; }
+    const std::vector<double>& denominator() const { return denominator_; }
+
+    // Вещественные полюса по возрастанию и их кратности. Общие корни
+    // числителя и знаменателя (устранимые разрывы) тоже попадают сюда -
+    // лишняя точка разбиения на результат не влияет.
+    const std::vector<double>& poles() const { return poles_; }
+    const std::vector<int>& multiplicities() const { return multiplicities_; }
+
+private:
+    std::vector<double> numerator_;
+    std::vector<double> denominator_;
+    std::vector<double> poles_;
+    std::vector<int> multiplicities_;
+};
+
+namespace detail {
+
+// Функтор сообщает свои полюса методом poles()
+template <typename Function, typename = void>
+struct has_poles : std::false_type {};
+
+template <typename Function>
+struct has_poles<Function, std::void_t<decltype(std::declval<const Function&>().poles())>>
+    : std::true_type {};
+
+} // namespace detail
+
+// Полюса функции на отрезке [a, b], включая концы (с допуском tolerance)
+template <typename Function>
+std::vector<double> poles_in(const Function& f, double a, double b, double tolerance = 0.0) {
+    std::vector<double> result;
+    if constexpr (detail::has_poles<Function>::value) {
+        for (double pole : f.poles()) {
+            if (pole >= a - tolerance && pole <= b + tolerance) {
+                result.push_back(pole);
+            }
+        }
+    } else {
+        (void)f;
+        (void)a;
+        (void)b;
+        (void)tolerance;
+    }
+    return result;
+}
+
+// Точки разбиения: a, полюса строго внутри (a, b), b
+template <typename Function>
+std::vector<double> breakpoints(const Function& f, double a, double b) {
+    std::vector<double> points{a};
+    for (double pole : poles_in(f, a, b)) {
+        if (pole > a && pole < b) {
+            points.push_back(pole);
+        }
+    }
+    points.push_back(b);
+    return points;
+}
+
+// Применить правило rule(f, left, right) к каждой части между полюсами и
+// сложить результаты. Для функций без poles() это один вызов rule(f, a, b).
+// Если внутри есть неинтегрируемый полюс, части дают бесконечные (или
+// расходящиеся) значения - как и должно быть для несобственного интеграла.
+template <typename Function, typename Rule>
+double piecewise(const Function& f, double a, double b, Rule&& rule) {
+    std::vector<double> points = breakpoints(f, a, b);
+    double total = 0.0;
+    for (std::size_t i = 0; i + 1 < points.size(); i++) {
+        total += rule(f, points[i], points[i + 1]);
+    }
+    return total;
+}
+
+} // namespace integration
+
+#endif // RATIONAL_H
@@ -0,0 +1,105 @@
+#ifndef REFINEMENT_H
+#define REFINEMENT_H
+
+#include <climits>
+#include <cmath>
+#include <cstdint>
+#include <iostream>
+#include <limits>
+#include <utility>
+
+#include "integration.h"
+
+// Последовательное удвоение сетки без повторных вычислений функции.
+// Объект хранит сумму значений во внутренних узлах текущей сетки; при каждом
+// удвоении вычисляются только новые узлы - середины текущих отрезков:
+//   M_n  = h * sum f(a + (i + 0.5) h)       (правило средних точек, n частей)
+//   T_2n = (T_n + M_n) / 2                  (трапеции, 2n частей)
+//   S_2n = (4 T_2n - T_n) / 3               (Симпсон, 2n частей)
+//   L_2n = h/2 * (f(a) + внутренние узлы)   (левые прямоугольники, 2n частей)
+
+namespace integration {
+
+template <typename Function, typename Execution = sequential_execution>
+class refinement {
+public:
+    // При parts <= 0 сетка не строится: все оценки - NaN, удвоение невозможно
+    refinement(Function f, double a, double b, int parts, Execution execution = Execution())
+        : f_(std::move(f)), execution_(std::move(execution)), a_(a), b_(b), parts_(parts) {
+        INTEGRATION_RULE_SCOPE("refinement");
+        if (parts_ <= 0) {
+            std::cerr << "Ошибка: n должно быть положительным" << std::endl;
+            fa_ = fb_ = interior_ = std::numeric_limits<double>::quiet_NaN();
+            return;
+        }
+        INTEGRATION_COUNT_EVALUATIONS(2);
+        fa_ = f_(a_);
+        fb_ = f_(b_);
+        interior_ = execution_.sum_nodes(f_, a_, step(), 0.0, 1, parts_);
+        evaluations_ = static_cast<std::int64_t>(parts_) + 1;
+    }
+
+    // Удвоить число разбиений; false, если удваивать больше нельзя
+    bool refine() {
+        if (parts_ <= 0 || parts_ > INT_MAX / 2) {
+            return false;
+        }
+        INTEGRATION_RULE_SCOPE("refinement");
+        double h = step();
+        double midpoints = execution_.sum_nodes(f_, a_, h, 0.5, 0, parts_);
+        evaluations_ += parts_;
+
+        previous_trapezoid_ = trapezoid();
+        midpoint_ = midpoints * h;
+        interior_ += midpoints;
+        parts_ *= 2;
+        return true;
+    }
+
+    // Текущее число разбиений
+    int parts() const { return parts_; }
+
+    // Сколько раз вычислялась функция за всё время
+    std::int64_t evaluations() const { return evaluations_; }
+
+    // Метод трапеций на текущей сетке
+    double trapezoid() const { return step() * ((fa_ + fb_) / 2 + interior_); }
+
+    // Метод левых прямоугольников на текущей сетке
+    double left_rectangles() const { return step() * (fa_ + interior_); }
+
+    // Метод Симпсона на текущей сетке (доступен после первого удвоения)
+    double simpson() const {
+        if (!refined()) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        return (4 * trapezoid() - previous_trapezoid_) / 3;
+    }
+
+    // Правило средних точек на предыдущей сетке (parts() / 2 частей) -
+    // его узлы и есть последние добавленные (доступно после первого удвоения)
+    double midpoint() const {
+        if (!refined()) {
+            return std::numeric_limits<double>::quiet_NaN();
+        }
+        return midpoint_;
+    }
+
+private:
+    double step() const { return (b_ - a_) / parts_; }
+    bool refined() const { return !std::isnan(previous_trapezoid_); }
+
+    Function f_;
+    Execution execution_;
+    double a_, b_;
+    int parts_;
+    double fa_ = 0.0, fb_ = 0.0;
+    double interior_ = 0.0;
+    double previous_trapezoid_ = std::numeric_limits<double>::quiet_NaN();
+    double midpoint_ = std::numeric_limits<double>::quiet_NaN();
+    std::int64_t evaluations_ = 0;
+};
+
+} // namespace integration
+
+#endif // REFINEMENT_H
@@ -0,0 +1,72 @@
+#ifndef ROMBERG_H
+#define ROMBERG_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+#include "instrumentation.h"
+#include "integration.h"
+#include "refinement.h"
+
+// Метод Ромберга: экстраполяция Ричардсона над последовательностью
+// трапеций T_1, T_2, T_4, ... из refinement (каждый узел вычисляется один раз).
+//   R(k, 0) = T_{2^k}
+//   R(k, j) = R(k, j-1) + (R(k, j-1) - R(k-1, j-1)) / (4^j - 1)
+// Остановка - как только два соседних диагональных элемента отличаются
+// меньше max(abs_tol, rel_tol * |R(k, k)|).
+
+namespace integration {
+
+// Результат метода Ромберга
+struct romberg_result {
+    double value;              // последний диагональный элемент таблицы
+    double error;              // оценка погрешности |R(k, k) - R(k-1, k-1)|
+    std::int64_t evaluations;  // число вычислений функции
+    int levels;                // число строк таблицы
+    bool converged;            // достигнута ли требуемая точность
+};
+
+template <typename Function, typename Execution = sequential_execution>
+romberg_result romberg(Function f, double a, double b, double abs_tol, double rel_tol = 0.0,
+                       int max_levels = 25, Execution execution = Execution()) {
+    INTEGRATION_RULE_SCOPE("romberg");
+    const int min_levels = 4; // защита от случайного совпадения на грубых сетках
+
+    refinement<Function, Execution> grid(std::move(f), a, b, 1, std::move(execution));
+    std::vector<double> previous(1, grid.trapezoid());
+    std::vector<double> current;
+    romberg_result result{previous[0], std::numeric_limits<double>::infinity(),
+                          grid.evaluations(), 1, false};
+
+    for (int k = 1; k < max_levels; k++) {
+        if (!grid.refine()) {
+            break;
+        }
+        current.assign(k + 1, 0.0);
+        current[0] = grid.trapezoid();
+        double factor = 1.0;
+        for (int j = 1; j <= k; j++) {
+            factor *= 4.0;
+            current[j] = current[j - 1] + (current[j - 1] - previous[j - 1]) / (factor - 1.0);
+        }
+
+        result.value = current[k];
+        result.error = std::abs(current[k] - previous[k - 1]);
+        result.evaluations = grid.evaluations();
+        result.levels = k + 1;
+
+        double tolerance = std::fmax(abs_tol, rel_tol * std::abs(current[k]));
+        if (k + 1 >= min_levels && result.error <= tolerance) {
+            result.converged = true;
+            break;
+        }
+        previous.swap(current);
+    }
+    return result;
+}
+
+} // namespace integration
+
+#endif // ROMBERG_H
@@ -0,0 +1,647 @@
+#ifndef SERVICE_H
+#define SERVICE_H
+
+#include <cmath>
+#include <csignal>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <map>
+#include <memory>
+#include <string>
+
+#ifdef __unix__
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#endif
+
+#include "expression.h"
+#include "function.h"
+#include "gauss_kronrod.h"
+#include "gauss_legendre.h"
+#include "integration.h"
+#include "principal_value.h"
+#include "romberg.h"
+#include "tanh_sinh.h"
+
+// Долгоживущий режим: запросы на интегрирование по одному JSON-объекту в
+// строке, ответ - тоже одна строка JSON, в том же порядке. Процесс и его
+// состояние (скомпилированные выражения, рабочая память Гаусса-Кронрода,
+// таблицы tanh-sinh) сохраняются между запросами, поэтому небольшой запрос
+// стоит микросекунды, а не запуск программы.
+//
+// Запрос:
+//   {"id": 1, "function": "rational", "a": 0, "b": 1, "rule": "simpson", "n": 1000}
+//   {"id": "q2", "expression": "sin(x)/x", "a": 1, "b": 10, "rule": "gauss_kronrod", "tol": 1e-12}
+//   {"command": "shutdown"}
+// function: rational, sine, inverse_root, secant (function.h) - или expression
+// (синтаксис expression.h). rule: rectangles, midpoint, trapezoid, simpson
+// (n частей, по умолчанию 1000), gauss_legendre (order узлов, по умолчанию 16,
+// на n частях, по умолчанию 1), gauss_kronrod, tanh_sinh, romberg (tol,
+// по умолчанию 1e-10), cauchy (n частей) и principal_value (tol) с полюсом
+// singularity.
+//
+// Ответ:
+//   {"id": 1, "status": "ok", "value": 0.2027..., "evaluations": 1001}
+//   {"id": "q2", "status": "ok", "value": ..., "error": ..., "evaluations": 21, "converged": true}
+//   {"id": 3, "status": "error", "message": "..."}
+// id возвращается тем же значением; нечисловые значения (NaN, inf) - null.
+// Числа в запросе - только по грамматике JSON (без nan, inf и 0x...).
+// Строка запроса - не длиннее 64 КиБ, вложенность выражения - не больше 256.
+
+namespace integration {
+
+namespace detail {
+
+// Значение поля плоского JSON-объекта
+struct json_field {
+    enum class type { string, number, boolean, null } kind = type::null;
+    std::string text;   // строка без кавычек или исходная запись значения
+    double number = 0.0;
+    bool flag = false;
+};
+
+// Разбор плоского объекта {"ключ": значение, ...}: строки, числа, true,
+// false, null. Вложенные объекты и массивы запросам не нужны.
+class json_object_parser {
+public:
+    explicit json_object_parser(const std::string& text) : text_(text) {}
+
+    bool parse(std::map<std::string, json_field>& fields, std::string& error) {
+        skip_spaces();
+        if (!take('{')) {
+            error = "ожидается JSON-объект";
+            return false;
+        }
+        skip_spaces();
+        if (take('}')) {
+            return finish(error);
+        }
+        for (;;) {
+            std::string key;
+            skip_spaces();
+            if (!parse_string(key)) {
+                error = "ожидается имя поля в кавычках";
+                return false;
+            }
+            skip_spaces();
+            if (!take(':')) {
+                error = "ожидается ':' после \"" + key + "\"";
+                return false;
+            }
+            skip_spaces();
+            json_field value;
+            if (!parse_value(value)) {
+                error = "некорректное значение поля \"" + key + "\"";
+                return false;
+            }
+            fields[key] = value;
+            skip_spaces();
+            if (take('}')) {
+                return finish(error);
+            }
+            if (!take(',')) {
+                error = "ожидается ',' или '}'";
+                return false;
+            }
+        }
+    }
+
+private:
+    bool finish(std::string& error) {
+        skip_spaces();
+        if (position_ != text_.size()) {
+            error = "лишние символы после объекта";
+            return false;
+        }
+        return true;
+    }
+
+    void skip_spaces() {
+        while (position_ < text_.size() && (text_[position_] == ' ' || text_[position_] == '\t' ||
+                                            text_[position_] == '\r' || text_[position_] == '\n')) {
+            position_++;
+        }
+    }
+
+    bool take(char c) {
+        if (position_ < text_.size() && text_[position_] == c) {
+            position_++;
+            return true;
+        }
+        return false;
+    }
+
+    bool parse_string(std::string& out) {
+        if (!take('"')) {
+            return false;
+        }
+        while (position_ < text_.size()) {
+            char c = text_[position_++];
+            if (c == '"') {
+                return true;
+            }
+            if (c != '\\') {
+                out += c;
+                continue;
+            }
+            if (position_ >= text_.size()) {
+                return false;
+            }
+            char escaped = text_[position_++];
+            switch (escaped) {
+            case '"': case '\\': case '/': out += escaped; break;
+            case 'n': out += '\n'; break;
+            case 't': out += '\t'; break;
+            case 'r': out += '\r'; break;
+            case 'b': out += '\b'; break;
+            case 'f': out += '\f'; break;
+            case 'u': {
+                // \uXXXX: в запросах встречаются только символы ASCII
+                if (position_ + 4 > text_.size()) {
+                    return false;
+                }
+                unsigned long code = std::strtoul(text_.substr(position_, 4).c_str(), nullptr, 16);
+                if (code >= 0x80) {
+                    return false;
+                }
+                out += static_cast<char>(code);
+                position_ += 4;
+                break;
+            }
+            default: return false;
+            }
+        }
+        return false;
+    }
+
+    bool parse_value(json_field& value) {
+        std::size_t start = position_;
+        if (position_ < text_.size() && text_[position_] == '"') {
+            value.kind = json_field::type::string;
+            return parse_string(value.text);
+        }
+        for (const char* word : {"true", "false", "null"}) {
+            std::size_t length = std::strlen(word);
+            if (text_.compare(position_, length, word) == 0) {
+                position_ += length;
+                value.kind = word[0] == 'n' ? json_field::type::null : json_field::type::boolean;
+                value.flag = word[0] == 't';
+                value.text = word;
+                return true;
+            }
+        }
+        if (!skip_number()) {
+            return false;
+        }
+        value.kind = json_field::type::number;
+        value.text = text_.substr(start, position_ - start);
+        value.number = std::strtod(value.text.c_str(), nullptr);
+        return std::isfinite(value.number); // 1e999 и т.п.
+    }
+
+    // Число по грамматике JSON: -?(0|[1-9][0-9]*)(.[0-9]+)?([eE][+-]?[0-9]+)?
+    // (strtod принял бы и nan, inf, шестнадцатеричную запись)
+    bool skip_number() {
+        take('-');
+        if (!take('0') && skip_digits() == 0) {
+            return false;
+        }
+        if (take('.') && skip_digits() == 0) {
+            return false;
+        }
+        if (take('e') || take('E')) {
+            if (!take('+')) {
+                take('-');
+            }
+            if (skip_digits() == 0) {
+                return false;
+            }
+        }
+        return true;
+    }
+
+    std::size_t skip_digits() {
+        std::size_t start = position_;
+        while (position_ < text_.size() && text_[position_] >= '0' && text_[position_] <= '9') {
+            position_++;
+        }
+        return position_ - start;
+    }
+
+    const std::string& text_;
+    std::size_t position_ = 0;
+};
+
+// Строка ответа: поля добавляются по порядку
+class json_writer {
+public:
+    static std::string quote(const std::string& value) {
+        std::string quoted = "\"";
+        for (char c : value) {
+            if (c == '"' || c == '\\') {
+                quoted += '\\';
+                quoted += c;
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                char escaped[8];
+                std::snprintf(escaped, sizeof(escaped), "\\u%04x", static_cast<unsigned>(c));
+                quoted += escaped;
+            } else {
+                quoted += c;
+            }
+        }
+        return quoted + "\"";
+    }
+
+    json_writer& raw(const char* key, const std::string& value) {
+        text_ += text_.size() > 1 ? ", \"" : "\"";
+        text_ += key;
+        text_ += "\": ";
+        text_ += value;
+        return *this;
+    }
+
+    json_writer& string(const char* key, const std::string& value) { return raw(key, quote(value)); }
+
+    json_writer& number(const char* key, double value) {
+        if (!std::isfinite(value)) {
+            return raw(key, "null");
+        }
+        char buffer[32];
+        std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+        return raw(key, buffer);
+    }
+
+    json_writer& integer(const char* key, std::int64_t value) {
+        return raw(key, std::to_string(value));
+    }
+
+    json_writer& boolean(const char* key, bool value) { return raw(key, value ? "true" : "false"); }
+
+    std::string str() const { return text_ + "}"; }
+
+private:
+    std::string text_ = "{";
+};
+
+// Разобранный запрос на интегрирование
+struct integration_request {
+    std::string function;
+    std::string expression;
+    std::string rule = "simpson";
+    double a = 0.0, b = 0.0;
+    int n = 0;                 // 0 - по умолчанию для правила
+    int order = 16;
+    double tol = 1e-10;
+    double singularity = std::numeric_limits<double>::quiet_NaN();
+};
+
+// Результат правила; error и converged есть только у адаптивных правил
+struct integration_answer {
+    double value = 0.0;
+    std::int64_t evaluations = 0;
+    bool adaptive = false;
+    double error = 0.0;
+    bool converged = false;
+};
+
+} // namespace detail
+
+// Обработчик запросов; состояние сохраняется между запросами
+class service {
+public:
+    service() : workspace_(max_segments) {
+        tanh_sinh_table::instance(); // узлы tanh-sinh строятся один раз при запуске
+    }
+
+    // После запроса {"command": "shutdown"}
+    bool stopped() const { return stopped_; }
+
+    // Ответ на одну строку запроса (без перевода строки)
+    std::string handle(const std::string& line) {
+        detail::json_writer answer;
+        if (line.size() > max_request_length) {
+            return too_long(answer);
+        }
+        std::map<std::string, detail::json_field> fields;
+        std::string error;
+        if (!detail::json_object_parser(line).parse(fields, error)) {
+            return failure(answer, error);
+        }
+        auto id = fields.find("id");
+        if (id != fields.end()) {
+            if (id->second.kind == detail::json_field::type::string) {
+                answer.string("id", id->second.text);
+            } else if (id->second.kind == detail::json_field::type::number) {
+                answer.number("id", id->second.number);
+            } else {
+                answer.raw("id", id->second.text);
+            }
+        }
+        auto command = fields.find("command");
+        if (command != fields.end()) {
+            if (command->second.text == "shutdown") {
+                stopped_ = true;
+                return answer.string("status", "ok").str();
+            }
+            return failure(answer, "неизвестная команда \"" + command->second.text + "\"");
+        }
+
+        detail::integration_request request;
+        if (!read_request(fields, request, error)) {
+            return failure(answer, error);
+        }
+        detail::integration_answer result;
+        bool done = false;
+        auto run = [&](const auto& f) { done = integrate(f, request, result, error); };
+        if (!request.expression.empty()) {
+            const expression* compiled = compile(request.expression, error);
+            if (compiled) {
+                run(*compiled);
+            }
+        } else if (request.function == "rational") {
+            run(rational_function{});
+        } else if (request.function == "sine") {
+            run(sine_function{});
+        } else if (request.function == "inverse_root") {
+            run(inverse_root_function{});
+        } else if (request.function == "secant") {
+            run(secant_function{});
+        } else {
+            error = "неизвестная функция \"" + request.function + "\"";
+        }
+        if (!done) {
+            return failure(answer, error);
+        }
+
+        answer.string("status", "ok").number("value", result.value);
+        if (result.adaptive) {
+            answer.number("error", result.error);
+        }
+        answer.integer("evaluations", result.evaluations);
+        if (result.adaptive) {
+            answer.boolean("converged", result.converged);
+        }
+        return answer.str();
+    }
+
+    // Запросы из in, ответы в out (каждый ответ сразу отправляется);
+    // до конца ввода, команды shutdown или ошибки записи. Строка длиннее
+    // max_request_length не накапливается: остаток пропускается до перевода
+    // строки, и на неё приходит ответ с ошибкой
+    void serve(std::FILE* in, std::FILE* out) {
+        std::string line;
+        bool overflow = false;
+        char buffer[4096];
+        while (!stopped_ && std::fgets(buffer, sizeof(buffer), in)) {
+            std::size_t length = std::strlen(buffer);
+            if (!overflow) {
+                line += buffer;
+                if (line.size() > max_request_length + 2) { // с \r\n
+                    overflow = true;
+                    line.clear();
+                }
+            }
+            bool complete = (length > 0 && buffer[length - 1] == '\n') || std::feof(in);
+            if (!complete) {
+                continue; // строка длиннее буфера
+            }
+            while (!line.empty() && (line.back() == '\n' || line.back() == '\r')) {
+                line.pop_back();
+            }
+            if (overflow || line.find_first_not_of(" \t") != std::string::npos) {
+                detail::json_writer answer;
+                std::string response = overflow ? too_long(answer) : handle(line);
+                response += '\n';
+                if (std::fwrite(response.data(), 1, response.size(), out) != response.size() ||
+                    std::fflush(out) != 0) {
+                    return; // читатель ушёл (клиент закрыл соединение)
+                }
+            }
+            line.clear();
+            overflow = false;
+        }
+    }
+
+    // Unix-сокет path: клиенты обслуживаются по очереди, каждый - до
+    // закрытия соединения; false, если сокет не удалось открыть.
+    // SIGPIPE игнорируется: клиент, закрывший соединение до ответа,
+    // даёт ошибку записи, и обрывается только его соединение
+    bool serve_socket(const std::string& path) {
+#ifdef __unix__
+        std::signal(SIGPIPE, SIG_IGN);
+        sockaddr_un address{};
+        if (path.size() >= sizeof(address.sun_path)) {
+            std::fprintf(stderr, "Ошибка: слишком длинный путь сокета %s\n", path.c_str());
+            return false;
+        }
+        int listener = ::socket(AF_UNIX, SOCK_STREAM, 0);
+        if (listener < 0) {
+            std::perror("socket");
+            return false;
+        }
+        address.sun_family = AF_UNIX;
+        std::strcpy(address.sun_path, path.c_str());
+        ::unlink(path.c_str());
+        if (::bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address)) != 0 ||
+            ::listen(listener, 16) != 0) {
+            std::perror(path.c_str());
+            ::close(listener);
+            return false;
+        }
+        while (!stopped_) {
+            int connection = ::accept(listener, nullptr, nullptr);
+            if (connection < 0) {
+                continue;
+            }
+            std::FILE* in = ::fdopen(connection, "r");
+            int output = ::dup(connection);
+            std::FILE* out = output >= 0 ? ::fdopen(output, "w") : nullptr;
+            if (in && out) {
+                serve(in, out);
+            }
+            if (out) {
+                std::fclose(out);
+            } else if (output >= 0) {
+                ::close(output);
+            }
+            if (in) {
+                std::fclose(in);
+            } else {
+                ::close(connection);
+            }
+        }
+        ::close(listener);
+        ::unlink(path.c_str());
+        return true;
+#else
+        std::fprintf(stderr, "Ошибка: Unix-сокеты недоступны (%s)\n", path.c_str());
+        return false;
+#endif
+    }
+
+private:
+    static constexpr std::size_t max_segments = 2000;
+    static constexpr std::size_t max_expressions = 256;
+    // Наибольшая длина строки запроса (байт)
+    static constexpr std::size_t max_request_length = 64 * 1024;
+    // Наибольшие n и order: Симпсон добавляет к нечётному n ещё одну часть
+    static constexpr int max_count = std::numeric_limits<int>::max() - 1;
+
+    static std::string failure(detail::json_writer& answer, const std::string& message) {
+        return answer.string("status", "error").string("message", message).str();
+    }
+
+    static std::string too_long(detail::json_writer& answer) {
+        return failure(answer, "запрос длиннее " + std::to_string(max_request_length) + " байт");
+    }
+
+    static bool read_request(const std::map<std::string, detail::json_field>& fields,
+                             detail::integration_request& request, std::string& error) {
+        for (const auto& field : fields) {
+            const std::string& key = field.first;
+            const detail::json_field& value = field.second;
+            bool text = key == "function" || key == "expression" || key == "rule";
+            if (key == "id") {
+                continue;
+            }
+            detail::json_field::type expected =
+                text ? detail::json_field::type::string : detail::json_field::type::number;
+            if (value.kind != expected) {
+                error = "неверный тип поля \"" + key + "\"";
+                return false;
+            }
+            if (key == "function") {
+                request.function = value.text;
+            } else if (key == "expression") {
+                request.expression = value.text;
+            } else if (key == "rule") {
+                request.rule = value.text;
+            } else if (key == "a") {
+                request.a = value.number;
+            } else if (key == "b") {
+                request.b = value.number;
+            } else if (key == "n" || key == "order") {
+                if (!(value.number >= 1.0 && value.number <= max_count) ||
+                    value.number != std::floor(value.number)) {
+                    error = "поле \"" + key + "\" должно быть целым от 1 до " +
+                            std::to_string(max_count);
+                    return false;
+                }
+                if (key == "n") {
+                    request.n = static_cast<int>(value.number);
+                } else {
+                    request.order = static_cast<int>(value.number);
+                }
+            } else if (key == "tol") {
+                request.tol = value.number;
+            } else if (key == "singularity") {
+                request.singularity = value.number;
+            } else {
+                error = "неизвестное поле \"" + key + "\"";
+                return false;
+            }
+        }
+        if (!fields.count("a") || !fields.count("b")) {
+            error = "нужны пределы интегрирования a и b";
+            return false;
+        }
+        if (request.function.empty() == request.expression.empty()) {
+            error = "нужно одно из полей function или expression";
+            return false;
+        }
+        if (!(request.tol > 0)) {
+            error = "tol должно быть положительным";
+            return false;
+        }
+        return true;
+    }
+
+    // Скомпилированное выражение из кэша; nullptr и error, если оно некорректно
+    const expression* compile(const std::string& text, std::string& error) {
+        auto cached = expressions_.find(text);
+        if (cached == expressions_.end()) {
+            if (expressions_.size() >= max_expressions) {
+                expressions_.clear();
+            }
+            cached = expressions_.emplace(text, std::make_unique<expression>(text)).first;
+        }
+        if (!cached->second->valid()) {
+            error = cached->second->error();
+            return nullptr;
+        }
+        return cached->second.get();
+    }
+
+    template <typename Function>
+    bool integrate(const Function& f, const detail::integration_request& request,
+                   detail::integration_answer& result, std::string& error) {
+        const std::string& rule = request.rule;
+        const double a = request.a, b = request.b;
+        const int n = request.n > 0 ? request.n : 1000;
+        // Адаптивные правила копируют функцию - передаётся ссылка
+        auto call = [&f](double x) { return f(x); };
+        auto adaptive = [&result](const auto& r) {
+            result.value = r.value;
+            result.error = r.error;
+            result.evaluations = r.evaluations;
+            result.converged = r.converged;
+            result.adaptive = true;
+        };
+
+        if (rule == "rectangles") {
+            result.value = rectangles(f, a, b, n);
+            result.evaluations = n;
+        } else if (rule == "midpoint") {
+            result.value = midpoint_rule(f, a, b, n);
+            result.evaluations = n;
+        } else if (rule == "trapezoid") {
+            result.value = trapezoid(f, a, b, n);
+            result.evaluations = static_cast<std::int64_t>(n) + 1;
+        } else if (rule == "simpson") {
+            result.value = simpson(f, a, b, n);
+            result.evaluations = static_cast<std::int64_t>(n + n % 2) + 1;
+        } else if (rule == "gauss_legendre") {
+            if (request.order < 1 || request.order > gauss_legendre_max_order) {
+                error = "order должен быть от 1 до 64";
+                return false;
+            }
+            // n для этого правила - число частей, по умолчанию одна
+            int parts = request.n > 0 ? request.n : 1;
+            result.value = gauss_legendre(f, a, b, request.order, parts);
+            result.evaluations = static_cast<std::int64_t>(request.order) * parts;
+        } else if (rule == "gauss_kronrod") {
+            adaptive(gauss_kronrod(call, a, b, request.tol, 0.0, workspace_));
+        } else if (rule == "tanh_sinh") {
+            adaptive(tanh_sinh(call, a, b, request.tol));
+        } else if (rule == "romberg") {
+            adaptive(romberg(call, a, b, request.tol));
+        } else if (rule == "cauchy" || rule == "principal_value") {
+            if (std::isnan(request.singularity)) {
+                error = "для правила " + rule + " нужно поле singularity";
+                return false;
+            }
+            if (rule == "cauchy") {
+                result.value = cauchy_principal_value(f, a, b, n, request.singularity);
+                result.evaluations = n;
+            } else {
+                adaptive(principal_value(call, a, b, request.singularity, request.tol, request.tol));
+            }
+        } else {
+            error = "неизвестное правило \"" + rule + "\"";
+            return false;
+        }
+        return true;
+    }
+
+    gauss_kronrod_workspace workspace_;
+    std::map<std::string, std::unique_ptr<expression>> expressions_;
+    bool stopped_ = false;
+};
+
+} // namespace integration
+
+#endif // SERVICE_H
@@ -0,0 +1,313 @@
+#ifndef SIMD_H
+#define SIMD_H
+
+#include <cstddef>
+#include <cstdint>
+
+// Векторные ядра для рациональной функции 1/(x^2 + p*x + q).
+// Узлы генерируются сразу векторами, функция вычисляется в нескольких
+// дорожках одновременно, а сумма набирается в четырёх независимых
+// аккумуляторах, чтобы не упираться в задержку сложения.
+// Пакетные ядра (rational_batch_*) векторизуют не по узлам, а по задачам:
+// каждая дорожка интегрирует свою функцию (p, q) на своём отрезке [a, b],
+// поэтому даже при нескольких узлах вектор заполнен целиком.
+// Нужное ядро (AVX-512, AVX2+FMA или SSE2) выбирается один раз во время
+// выполнения по возможностям процессора. На других архитектурах и при
+// INTEGRATION_NO_SIMD используется скалярное ядро.
+
+#if !defined(INTEGRATION_NO_SIMD) && (defined(__x86_64__) || defined(__i386__)) && \
+    (defined(__GNUC__) || defined(__clang__))
+#define INTEGRATION_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace integration {
+namespace simd {
+
+// Сигнатура ядра: сумма 1/(x^2 + p*x + q) по узлам
+// x_k = start + (base + k * stride) * step, k = 0 .. count-1
+using rational_kernel = double (*)(double p, double q, double start, double step,
+                                   double base, std::int64_t count, int stride);
+
+// Скалярное ядро (и хвост для векторных ядер)
+inline double rational_sum_scalar(double p, double q, double start, double step,
+                                  double base, std::int64_t count, int stride) {
+    double total = 0.0;
+    for (std::int64_t k = 0; k < count; k++) {
+        double x = start + (base + static_cast<double>(k * stride)) * step;
+        total += 1.0 / (x * x + p * x + q);
+    }
+    return total;
+}
+
+// Сигнатура пакетного ядра: для i = 0 .. count-1 составное правило Гаусса
+// (nodes, weights - таблица на [-1, 1] из order узлов) на parts частях
+// [a_i, b_i] для 1/(x^2 + p_i x + q_i), результат в result_i
+using rational_batch_kernel = void (*)(const double* p, const double* q, const double* a,
+                                       const double* b, double* result, std::size_t count,
+                                       const double* nodes, const double* weights, int order,
+                                       int parts);
+
+inline void rational_batch_scalar(const double* p, const double* q, const double* a,
+                                  const double* b, double* result, std::size_t count,
+                                  const double* nodes, const double* weights, int order,
+                                  int parts) {
+    for (std::size_t i = 0; i < count; i++) {
+        const double h = (b[i] - a[i]) / parts;
+        const double half = 0.5 * h;
+        double total = 0.0;
+        for (int j = 0; j < parts; j++) {
+            const double center = a[i] + (j + 0.5) * h;
+            double sum = 0.0;
+            for (int k = 0; k < order; k++) {
+                double x = center + half * nodes[k];
+                sum += weights[k] / ((x + p[i]) * x + q[i]);
+            }
+            total += sum;
+        }
+        result[i] = total * half;
+    }
+}
+
+#ifdef INTEGRATION_X86_SIMD
+
+// SSE2: 2 дорожки x 4 аккумулятора
+__attribute__((target("sse2"))) inline double
+rational_sum_sse2(double p, double q, double start, double step,
+                  double base, std::int64_t count, int stride) {
+    const __m128d vp = _mm_set1_pd(p), vq = _mm_set1_pd(q), one = _mm_set1_pd(1.0);
+    const __m128d vstart = _mm_set1_pd(start), vstep = _mm_set1_pd(step);
+    const double s = stride;
+    __m128d t = _mm_set_pd(base + s, base);
+    const __m128d dt = _mm_set1_pd(2 * s);
+    __m128d acc[4] = {_mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd(), _mm_setzero_pd()};
+
+    std::int64_t k = 0;
+    for (; k + 8 <= count; k += 8) {
+        for (int j = 0; j < 4; j++) {
+            __m128d x = _mm_add_pd(vstart, _mm_mul_pd(t, vstep));
+            __m128d d = _mm_add_pd(_mm_mul_pd(_mm_add_pd(x, vp), x), vq);
+            acc[j] = _mm_add_pd(acc[j], _mm_div_pd(one, d));
+            t = _mm_add_pd(t, dt);
+        }
+    }
+    __m128d sum = _mm_add_pd(_mm_add_pd(acc[0], acc[1]), _mm_add_pd(acc[2], acc[3]));
+    double lanes[2];
+    _mm_storeu_pd(lanes, sum);
+    return lanes[0] + lanes[1] +
+           rational_sum_scalar(p, q, start, step, base + static_cast<double>(k * stride),
+                               count - k, stride);
+}
+
+// AVX2 + FMA: 4 дорожки x 4 аккумулятора
+__attribute__((target("avx2,fma"))) inline double
+rational_sum_avx2(double p, double q, double start, double step,
+                  double base, std::int64_t count, int stride) {
+    const __m256d vp = _mm256_set1_pd(p), vq = _mm256_set1_pd(q), one = _mm256_set1_pd(1.0);
+    const __m256d vstart = _mm256_set1_pd(start), vstep = _mm256_set1_pd(step);
+    const double s = stride;
+    __m256d t = _mm256_set_pd(base + 3 * s, base + 2 * s, base + s, base);
+    const __m256d dt = _mm256_set1_pd(4 * s);
+    __m256d acc[4] = {_mm256_setzero_pd(), _mm256_setzero_pd(),
+                      _mm256_setzero_pd(), _mm256_setzero_pd()};
+
+    std::int64_t k = 0;
+    for (; k + 16 <= count; k += 16) {
+        for (int j = 0; j < 4; j++) {
+            __m256d x = _mm256_fmadd_pd(t, vstep, vstart);
+            __m256d d = _mm256_fmadd_pd(_mm256_add_pd(x, vp), x, vq);
+            acc[j] = _mm256_add_pd(acc[j], _mm256_div_pd(one, d));
+            t = _mm256_add_pd(t, dt);
+        }
+    }
+    __m256d sum = _mm256_add_pd(_mm256_add_pd(acc[0], acc[1]), _mm256_add_pd(acc[2], acc[3]));
+    double lanes[4];
+    _mm256_storeu_pd(lanes, sum);
+    return (lanes[0] + lanes[1]) + (lanes[2] + lanes[3]) +
+           rational_sum_scalar(p, q, start, step, base + static_cast<double>(k * stride),
+                               count - k, stride);
+}
+
+// AVX-512: 8 дорожек x 4 аккумулятора
+__attribute__((target("avx512f"))) inline double
+rational_sum_avx512(double p, double q, double start, double step,
+                    double base, std::int64_t count, int stride) {
+    const __m512d vp = _mm512_set1_pd(p), vq = _mm512_set1_pd(q), one = _mm512_set1_pd(1.0);
+    const __m512d vstart = _mm512_set1_pd(start), vstep = _mm512_set1_pd(step);
+    const double s = stride;
+    __m512d t = _mm512_set_pd(base + 7 * s, base + 6 * s, base + 5 * s, base + 4 * s,
+                              base + 3 * s, base + 2 * s, base + s, base);
+    const __m512d dt = _mm512_set1_pd(8 * s);
+    __m512d acc[4] = {_mm512_setzero_pd(), _mm512_setzero_pd(),
+                      _mm512_setzero_pd(), _mm512_setzero_pd()};
+
+    std::int64_t k = 0;
+    for (; k + 32 <= count; k += 32) {
+        for (int j = 0; j < 4; j++) {
+            __m512d x = _mm512_fmadd_pd(t, vstep, vstart);
+            __m512d d = _mm512_fmadd_pd(_mm512_add_pd(x, vp), x, vq);
+            acc[j] = _mm512_add_pd(acc[j], _mm512_div_pd(one, d));
+            t = _mm512_add_pd(t, dt);
+        }
+    }
+    __m512d sum = _mm512_add_pd(_mm512_add_pd(acc[0], acc[1]), _mm512_add_pd(acc[2], acc[3]));
+    double lanes[8];
+    _mm512_storeu_pd(lanes, sum);
+    return ((lanes[0] + lanes[1]) + (lanes[2] + lanes[3])) +
+           ((lanes[4] + lanes[5]) + (lanes[6] + lanes[7])) +
+           rational_sum_scalar(p, q, start, step, base + static_cast<double>(k * stride),
+                               count - k, stride);
+}
+
+// Пакетное ядро AVX2 + FMA: 4 задачи в одном векторе
+__attribute__((target("avx2,fma"))) inline void
+rational_batch_avx2(const double* p, const double* q, const double* a, const double* b,
+                    double* result, std::size_t count, const double* nodes,
+                    const double* weights, int order, int parts) {
+    const __m256d vparts = _mm256_set1_pd(parts), half_one = _mm256_set1_pd(0.5);
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        const __m256d vp = _mm256_loadu_pd(p + i), vq = _mm256_loadu_pd(q + i);
+        const __m256d va = _mm256_loadu_pd(a + i);
+        const __m256d h = _mm256_div_pd(_mm256_sub_pd(_mm256_loadu_pd(b + i), va), vparts);
+        const __m256d half = _mm256_mul_pd(half_one, h);
+        __m256d total = _mm256_setzero_pd();
+        for (int j = 0; j < parts; j++) {
+            const __m256d center = _mm256_fmadd_pd(_mm256_set1_pd(j + 0.5), h, va);
+            __m256d sum = _mm256_setzero_pd();
+            int k = 0;
+            for (; k + 2 <= order; k += 2) {
+                __m256d x0 = _mm256_fmadd_pd(half, _mm256_set1_pd(nodes[k]), center);
+                __m256d x1 = _mm256_fmadd_pd(half, _mm256_set1_pd(nodes[k + 1]), center);
+                __m256d d0 = _mm256_fmadd_pd(_mm256_add_pd(x0, vp), x0, vq);
+                __m256d d1 = _mm256_fmadd_pd(_mm256_add_pd(x1, vp), x1, vq);
+                // w0/d0 + w1/d1 = (w0 d1 + w1 d0) / (d0 d1): одно деление на два узла
+                // (переполнения нет, пока |d| < 1e150)
+                __m256d numerator = _mm256_fmadd_pd(_mm256_set1_pd(weights[k]), d1,
+                                                    _mm256_mul_pd(_mm256_set1_pd(weights[k + 1]), d0));
+                sum = _mm256_add_pd(sum, _mm256_div_pd(numerator, _mm256_mul_pd(d0, d1)));
+            }
+            for (; k < order; k++) {
+                __m256d x = _mm256_fmadd_pd(half, _mm256_set1_pd(nodes[k]), center);
+                __m256d d = _mm256_fmadd_pd(_mm256_add_pd(x, vp), x, vq);
+                sum = _mm256_add_pd(sum, _mm256_div_pd(_mm256_set1_pd(weights[k]), d));
+            }
+            total = _mm256_add_pd(total, sum);
+        }
+        _mm256_storeu_pd(result + i, _mm256_mul_pd(total, half));
+    }
+    rational_batch_scalar(p + i, q + i, a + i, b + i, result + i, count - i,
+                          nodes, weights, order, parts);
+}
+
+// Пакетное ядро AVX-512: 8 задач в одном векторе
+__attribute__((target("avx512f"))) inline void
+rational_batch_avx512(const double* p, const double* q, const double* a, const double* b,
+                      double* result, std::size_t count, const double* nodes,
+                      const double* weights, int order, int parts) {
+    const __m512d vparts = _mm512_set1_pd(parts), half_one = _mm512_set1_pd(0.5);
+    std::size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        const __m512d vp = _mm512_loadu_pd(p + i), vq = _mm512_loadu_pd(q + i);
+        const __m512d va = _mm512_loadu_pd(a + i);
+        const __m512d h = _mm512_div_pd(_mm512_sub_pd(_mm512_loadu_pd(b + i), va), vparts);
+        const __m512d half = _mm512_mul_pd(half_one, h);
+        __m512d total = _mm512_setzero_pd();
+        for (int j = 0; j < parts; j++) {
+            const __m512d center = _mm512_fmadd_pd(_mm512_set1_pd(j + 0.5), h, va);
+            __m512d sum = _mm512_setzero_pd();
+            int k = 0;
+            for (; k + 2 <= order; k += 2) {
+                __m512d x0 = _mm512_fmadd_pd(half, _mm512_set1_pd(nodes[k]), center);
+                __m512d x1 = _mm512_fmadd_pd(half, _mm512_set1_pd(nodes[k + 1]), center);
+                __m512d d0 = _mm512_fmadd_pd(_mm512_add_pd(x0, vp), x0, vq);
+                __m512d d1 = _mm512_fmadd_pd(_mm512_add_pd(x1, vp), x1, vq);
+                // w0/d0 + w1/d1 = (w0 d1 + w1 d0) / (d0 d1): одно деление на два узла
+                // (переполнения нет, пока |d| < 1e150)
+                __m512d numerator = _mm512_fmadd_pd(_mm512_set1_pd(weights[k]), d1,
+                                                    _mm512_mul_pd(_mm512_set1_pd(weights[k + 1]), d0));
+                sum = _mm512_add_pd(sum, _mm512_div_pd(numerator, _mm512_mul_pd(d0, d1)));
+            }
+            for (; k < order; k++) {
+                __m512d x = _mm512_fmadd_pd(half, _mm512_set1_pd(nodes[k]), center);
+                __m512d d = _mm512_fmadd_pd(_mm512_add_pd(x, vp), x, vq);
+                sum = _mm512_add_pd(sum, _mm512_div_pd(_mm512_set1_pd(weights[k]), d));
+            }
+            total = _mm512_add_pd(total, sum);
+        }
+        _mm512_storeu_pd(result + i, _mm512_mul_pd(total, half));
+    }
+    rational_batch_scalar(p + i, q + i, a + i, b + i, result + i, count - i,
+                          nodes, weights, order, parts);
+}
+
+#endif // INTEGRATION_X86_SIMD
+
+// Выбор ядра по возможностям процессора
+inline rational_kernel select_rational_kernel() {
+#ifdef INTEGRATION_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return rational_sum_avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return rational_sum_avx2;
+    }
+    if (__builtin_cpu_supports("sse2")) {
+        return rational_sum_sse2;
+    }
+#endif
+    return rational_sum_scalar;
+}
+
+// Выбор пакетного ядра; без AVX2 используется скалярное
+inline rational_batch_kernel select_rational_batch_kernel() {
+#ifdef INTEGRATION_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return rational_batch_avx512;
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return rational_batch_avx2;
+    }
+#endif
+    return rational_batch_scalar;
+}
+
+// Имя выбранного ядра (для диагностики)
+inline const char* rational_kernel_name() {
+    rational_kernel kernel = select_rational_kernel();
+#ifdef INTEGRATION_X86_SIMD
+    if (kernel == rational_sum_avx512) return "avx512";
+    if (kernel == rational_sum_avx2) return "avx2";
+    if (kernel == rational_sum_sse2) return "sse2";
+#endif
+    (void)kernel;
+    return "scalar";
+}
+
+// Сумма 1/(x^2 + p*x + q) по узлам x = start + (base + k * stride) * step
+inline double rational_sum(double p, double q, double start, double step,
+                           double base, std::int64_t count, int stride = 1) {
+    static const rational_kernel kernel = select_rational_kernel();
+    if (count <= 0) {
+        return 0.0;
+    }
+    return kernel(p, q, start, step, base, count, stride);
+}
+
+// Пакетное интегрирование count задач (ядро выбирается один раз)
+inline void rational_batch(const double* p, const double* q, const double* a, const double* b,
+                           double* result, std::size_t count, const double* nodes,
+                           const double* weights, int order, int parts) {
+    static const rational_batch_kernel kernel = select_rational_batch_kernel();
+    if (count == 0) {
+        return;
+    }
+    kernel(p, q, a, b, result, count, nodes, weights, order, parts);
+}
+
+} // namespace simd
+} // namespace integration
+
+#endif // SIMD_H
@@ -0,0 +1,192 @@
+#ifndef SUMMATION_H
+#define SUMMATION_H
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Суммирование для политик выполнения.
+// В быстром режиме (fast) узлы суммируются векторными ядрами и порциями пула,
+// поэтому младшие биты результата зависят от ширины вектора и от того, как
+// узлы поделены между потоками. В воспроизводимом режиме (reproducible)
+// сумма набирается точно (exact_sum) и округляется один раз, а значения f
+// вычисляются скалярно по одной формуле узла. Результат тогда не зависит ни
+// от порядка сложения, ни от числа потоков, ни от набора команд процессора,
+// и ошибки округления при больших n не накапливаются.
+
+namespace integration {
+
+enum class summation_mode {
+    fast,         // векторные ядра, порядок сложения зависит от разбиения
+    reproducible  // точная сумма с одним округлением, одинаковые биты
+};
+
+// Точная сумма чисел double (алгоритм Шевчука, как math.fsum в Python):
+// хранится набор непересекающихся частичных сумм, их сумма равна сумме
+// всех слагаемых без округления. value() возвращает правильно округлённый
+// результат, поэтому он не зависит от порядка add и от слияния частей.
+// Переполнение промежуточной суммы не теряет частичные суммы: кратные 2^1023
+// копятся в отдельном счётчике, и M + M - M даёт M при любом порядке.
+class exact_sum {
+public:
+    void add(double x) {
+        if (!std::isfinite(x)) {
+            special_ += x; // inf и NaN складываются отдельно (порядок не важен)
+            return;
+        }
+        reserve_one();
+        double* partials = data();
+        int count = 0;
+        for (int j = 0; j < size_; j++) {
+            double y = partials[j];
+            if (std::abs(x) < std::abs(y)) {
+                std::swap(x, y);
+            }
+            double high = x + y;
+            while (!std::isfinite(high)) {
+                // Переполнение промежуточной суммы: 2^1023 уходит в счётчик
+                // carry_ (вычитание точное, слагаемое не меньше 2^1022)
+                double unit = std::copysign(overflow_unit, x);
+                if (std::abs(x) >= std::abs(y)) {
+                    x -= unit;
+                } else {
+                    y -= unit;
+                }
+                carry_ += unit > 0.0 ? 1 : -1;
+                if (std::abs(x) < std::abs(y)) {
+                    std::swap(x, y);
+                }
+                high = x + y;
+            }
+            double low = y - (high - x);
+            if (low != 0.0) {
+                partials[count++] = low;
+            }
+            x = high;
+        }
+        partials[count++] = x;
+        size_ = count;
+    }
+
+    // Прибавить другую точную сумму (например, сумму порции другого потока)
+    void add(const exact_sum& other) {
+        const double* partials = other.data();
+        for (int j = 0; j < other.size_; j++) {
+            add(partials[j]);
+        }
+        carry_ += other.carry_;
+        special_ += other.special_;
+    }
+
+    // Правильно округлённое значение суммы
+    double value() const {
+        if (special_ != 0.0 || std::isnan(special_)) {
+            return special_;
+        }
+        if (carry_ != 0) {
+            return carried_value();
+        }
+        const double* partials = data();
+        int n = size_;
+        double high = 0.0;
+        if (n > 0) {
+            high = partials[--n];
+            double low = 0.0;
+            while (n > 0) {
+                double x = high;
+                double y = partials[--n];
+                high = x + y;
+                low = y - (high - x);
+                if (low != 0.0) {
+                    break;
+                }
+            }
+            // Поправка округления к чётному, если остаток ровно половина ulp
+            if (n > 0 && ((low < 0.0 && partials[n - 1] < 0.0) ||
+                          (low > 0.0 && partials[n - 1] > 0.0))) {
+                double y = low * 2.0;
+                double x = high + y;
+                if (y == x - high) {
+                    high = x;
+                }
+            }
+        }
+        return high;
+    }
+
+private:
+    static constexpr double overflow_unit = 0x1p1023;
+
+    // Сумма carry_ * 2^1023 + частичные суммы. Частичные суммы по модулю
+    // меньше 2^1024, поэтому при |carry_| >= 4 результат - бесконечность;
+    // иначе сумма считается в половинном масштабе, где переполнения нет
+    // (младший бит субнормальных частичных сумм при этом теряется)
+    double carried_value() const {
+        if (carry_ >= 4 || carry_ <= -4) {
+            return std::copysign(std::numeric_limits<double>::infinity(),
+                                 static_cast<double>(carry_));
+        }
+        exact_sum half;
+        const double* partials = data();
+        for (int j = 0; j < size_; j++) {
+            half.add(partials[j] * 0.5);
+        }
+        for (std::int64_t c = 0; c < std::abs(carry_); c++) {
+            half.add(std::copysign(0.5 * overflow_unit, static_cast<double>(carry_)));
+        }
+        return 2.0 * half.value();
+    }
+
+    // Частичные суммы: обычно их немного и они лежат во встроенном массиве,
+    // при переполнении переносятся в spill_ (как в math.fsum)
+    static constexpr int inline_size = 32;
+
+    double* data() { return spill_.empty() ? inline_ : spill_.data(); }
+    const double* data() const { return spill_.empty() ? inline_ : spill_.data(); }
+
+    // Место для ещё одной частичной суммы
+    void reserve_one() {
+        int capacity = spill_.empty() ? inline_size : static_cast<int>(spill_.size());
+        if (size_ < capacity) {
+            return;
+        }
+        if (spill_.empty()) {
+            spill_.assign(inline_, inline_ + size_);
+        }
+        spill_.resize(2 * static_cast<std::size_t>(capacity));
+    }
+
+    double inline_[inline_size] = {};
+    std::vector<double> spill_;
+    int size_ = 0;
+    std::int64_t carry_ = 0;   // переполнения: сумма больше на carry_ * 2^1023
+    double special_ = 0.0;
+};
+
+// Точная сумма значений типа T; для составных типов (dual.h)
+// специализируется покомпонентно
+template <typename T>
+class exact_accumulator;
+
+template <>
+class exact_accumulator<double> : public exact_sum {};
+
+namespace detail {
+
+// Точная сумма f(start + (i + offset) * step), i = first, first + stride, ... < last;
+// векторные ядра функтора намеренно не используются
+template <typename Function, typename Accumulator>
+void sum_nodes_exact(Function& f, double start, double step, double offset,
+                     int first, int last, int stride, Accumulator& total) {
+    for (int i = first; i < last; i += stride) {
+        total.add(f(start + (i + offset) * step));
+    }
+}
+
+} // namespace detail
+
+} // namespace integration
+
+#endif // SUMMATION_H
@@ -0,0 +1,165 @@
+#ifndef SWEEP_H
+#define SWEEP_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <map>
+#include <mutex>
+#include <optional>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "instrumentation.h"
+#include "parallel.h"
+#include "refinement.h"
+#include "thread_pool.h"
+
+// Таблицы сходимости: одно и то же правило для списка чисел разбиений n.
+// Значения для разных n считаются одновременно в пуле потоков, а строки
+// выдаются функции emit строго по порядку списка - как только готовы все
+// предыдущие. Порядок выдачи и значения не зависят от числа потоков.
+// Для трапеций вложенные сетки (n, 2n, 4n, ...) считаются одной цепочкой
+// удвоений (refinement.h), так что узлы общих сеток не вычисляются повторно.
+
+namespace integration {
+
+// n = first, first + step, ..., не больше last
+inline std::vector<int> linear_counts(int first, int last, int step = 1) {
+    std::vector<int> counts;
+    for (std::int64_t n = first; n <= last && step > 0; n += step) {
+        counts.push_back(static_cast<int>(n));
+    }
+    return counts;
+}
+
+// per_decade значений на декаду от first до last (округлённых, без повторов)
+inline std::vector<int> log_counts(int first, int last, int per_decade = 10) {
+    std::vector<int> counts;
+    if (first <= 0 || last < first || per_decade <= 0) {
+        return counts;
+    }
+    const double ratio = std::pow(10.0, 1.0 / per_decade);
+    for (double value = first; value <= last * (1.0 + 1e-12); value *= ratio) {
+        int n = static_cast<int>(std::lround(value));
+        if (counts.empty() || n != counts.back()) {
+            counts.push_back(std::min(n, last));
+        }
+    }
+    if (counts.back() != last) {
+        counts.push_back(last);
+    }
+    return counts;
+}
+
+namespace detail {
+
+// Выдача результатов строго по порядку индексов
+template <typename Result, typename Emit>
+class ordered_emitter {
+public:
+    ordered_emitter(const std::vector<int>& counts, Emit& emit)
+        : counts_(counts), emit_(emit), results_(counts.size()), ready_(counts.size(), false) {}
+
+    void deliver(std::size_t index, Result result) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        results_[index] = std::move(result);
+        ready_[index] = true;
+        while (next_ < results_.size() && ready_[next_]) {
+            emit_(counts_[next_], results_[next_]);
+            next_++;
+        }
+    }
+
+private:
+    const std::vector<int>& counts_;
+    Emit& emit_;
+    std::vector<Result> results_;
+    std::vector<bool> ready_;
+    std::size_t next_ = 0;
+    std::mutex mutex_;
+};
+
+} // namespace detail
+
+// Для каждого n из counts вычислить compute(n) и передать emit(n, результат)
+// в порядке counts. Вызывающий поток тоже участвует в вычислениях и сам
+// забирает задачи с начала списка, так что первые строки выдаются сразу.
+template <typename Compute, typename Emit>
+void sweep(const std::vector<int>& counts, Compute&& compute, Emit&& emit,
+           thread_pool& pool = default_pool()) {
+    using Result = std::decay_t<std::invoke_result_t<Compute&, int>>;
+    detail::ordered_emitter<Result, std::remove_reference_t<Emit>> emitter(counts, emit);
+    parallel_for(pool, static_cast<std::int64_t>(counts.size()), [&](std::int64_t i) {
+        std::size_t index = static_cast<std::size_t>(i);
+        emitter.deliver(index, [&] {
+            INTEGRATION_ROW_SCOPE("sweep", counts[index]);
+            return compute(counts[index]);
+        }());
+    });
+}
+
+// Таблица сходимости метода трапеций. Числа вида n * 2^k образуют одну
+// цепочку удвоений: T_2n = (T_n + M_n) / 2 вычисляет только новые середины.
+// Цепочки с разной нечётной частью n выполняются параллельно.
+template <typename Function, typename Emit>
+void trapezoid_sweep(const Function& f, double a, double b, const std::vector<int>& counts,
+                     Emit&& emit, thread_pool& pool = default_pool()) {
+    // Нечётная часть -> индексы позиций с такой нечётной частью (по возрастанию n)
+    std::map<int, std::vector<std::size_t>> chains;
+    for (std::size_t i = 0; i < counts.size(); i++) {
+        if (counts[i] <= 0) {
+            continue;
+        }
+        int odd = counts[i];
+        while (odd % 2 == 0) {
+            odd /= 2;
+        }
+        chains[odd].push_back(i);
+    }
+    std::vector<std::vector<std::size_t>> groups;
+    for (auto& chain : chains) {
+        std::stable_sort(chain.second.begin(), chain.second.end(),
+                         [&](std::size_t x, std::size_t y) { return counts[x] < counts[y]; });
+        groups.push_back(std::move(chain.second));
+    }
+    // Цепочки в порядке первой позиции, чтобы начало таблицы было готово раньше
+    std::sort(groups.begin(), groups.end(),
+              [](const std::vector<std::size_t>& x, const std::vector<std::size_t>& y) {
+                  return *std::min_element(x.begin(), x.end()) <
+                         *std::min_element(y.begin(), y.end());
+              });
+
+    detail::ordered_emitter<double, std::remove_reference_t<Emit>> emitter(counts, emit);
+    // Некорректные n (<= 0) выдаются как NaN, чтобы не задерживать таблицу
+    for (std::size_t i = 0; i < counts.size(); i++) {
+        if (counts[i] <= 0) {
+            emitter.deliver(i, std::numeric_limits<double>::quiet_NaN());
+        }
+    }
+    parallel_execution inner(pool);
+    parallel_for(pool, static_cast<std::int64_t>(groups.size()), [&](std::int64_t g) {
+        const std::vector<std::size_t>& group = groups[static_cast<std::size_t>(g)];
+        // Сетка строится в первой строке цепочки, чтобы её вычисления
+        // относились к этой строке (instrumentation.h)
+        std::optional<refinement<const Function&, parallel_execution>> grid;
+        for (std::size_t index : group) {
+            emitter.deliver(index, [&] {
+                INTEGRATION_ROW_SCOPE("trapezoid_sweep", counts[index]);
+                if (!grid) {
+                    grid.emplace(f, a, b, counts[group[0]], inner);
+                }
+                while (grid->parts() < counts[index] && grid->refine()) {
+                }
+                return grid->trapezoid();
+            }());
+        }
+    });
+}
+
+} // namespace integration
+
+#endif // SWEEP_H
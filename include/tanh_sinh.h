@@ -0,0 +1,207 @@
+#ifndef TANH_SINH_H
+#define TANH_SINH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <type_traits>
+#include <vector>
+
+#include "instrumentation.h"
+
+// Двойное экспоненциальное преобразование (tanh-sinh).
+// Замена x = c + h * tanh(pi/2 * sinh t) сгущает узлы к концам отрезка
+// с двойной экспоненциальной скоростью, поэтому интегрируемые особенности
+// на концах (1/sqrt, ln и т.п.) обрабатываются за несколько десятков
+// вычислений функции. Узлы уровня l - нечётные кратные шага 2^-l, поэтому
+// при переходе на следующий уровень старые узлы не пересчитываются.
+// Узлы хранятся как расстояние до ближайшего конца (1 - u), чтобы точки
+// вблизи особенности не терялись при округлении. Если функция принимает
+// два аргумента f(x, d), ей передаётся и точное смещение от ближайшего
+// конца: d = x - a у левого конца и d = x - b у правого (например, для
+// 1/sqrt(1 - x) на [0, 1] можно вычислять 1/sqrt(-d)).
+
+namespace integration {
+
+// Узел преобразования: 1 - tanh(s) и вес pi/2 * cosh t / cosh^2 s
+struct tanh_sinh_node {
+    double complement;
+    double weight;
+};
+
+// Таблица уровней, вычисляется один раз при первом обращении
+class tanh_sinh_table {
+public:
+    static constexpr int max_levels = 12;
+    static constexpr double t_max = 6.5;
+
+    static const tanh_sinh_table& instance() {
+        static const tanh_sinh_table table;
+        return table;
+    }
+
+    // Узлы уровня level при t > 0 (по возрастанию t)
+    const std::vector<tanh_sinh_node>& level(int level) const { return levels_[level]; }
+
+private:
+    tanh_sinh_table() {
+        const double half_pi = 2.0 * std::atan(1.0);
+        for (int level = 0; level < max_levels; level++) {
+            double h = std::ldexp(1.0, -level);
+            // Уровень 0: t = 1, 2, ...; уровень l > 0: нечётные кратные 2^-l
+            int stride = level == 0 ? 1 : 2;
+            for (int k = 1; k * h <= t_max; k += stride) {
+                double t = k * h;
+                double s = half_pi * std::sinh(t);
+                double complement = 2.0 / (std::exp(2.0 * s) + 1.0);
+                double cosh_s = std::cosh(s);
+                double weight = half_pi * std::cosh(t) / (cosh_s * cosh_s);
+                if (complement == 0.0 || weight == 0.0) {
+                    break;
+                }
+                levels_[level].push_back({complement, weight});
+            }
+        }
+    }
+
+    std::vector<tanh_sinh_node> levels_[max_levels];
+};
+
+namespace detail {
+
+// Вызов f(x, d), если функция принимает смещение от конца, иначе f(x)
+template <typename Function>
+constexpr bool takes_offset = std::is_invocable_v<Function&, double, double>;
+
+template <typename Function>
+double call_with_offset(Function& f, double x, double offset) {
+    if constexpr (takes_offset<Function>) {
+        return f(x, offset);
+    } else {
+        (void)offset;
+        return f(x);
+    }
+}
+
+// Два самых близких к концу узла: расстояние d, d * |f| и вклад в сумму.
+// У интегрируемой особенности d * |f| к концу убывает, у 1/d и более
+// сильных - нет (допуск - на округление d * |f| у f = 1/d).
+struct edge_trend {
+    double distance[2] = {0.0, 0.0};
+    double moment[2] = {0.0, 0.0};
+    double contribution = 0.0;
+    int count = 0;
+
+    void add(double d, double value, double weighted) {
+        if (count > 0 && !(d < distance[1])) {
+            return;
+        }
+        distance[0] = distance[1];
+        moment[0] = moment[1];
+        distance[1] = d;
+        moment[1] = d * std::abs(value);
+        contribution = weighted;
+        count = std::min(count + 1, 2);
+    }
+
+    void merge(const edge_trend& other) {
+        if (other.count > 0 && (count == 0 || other.distance[1] < distance[1])) {
+            distance[1] = other.distance[1];
+            contribution = other.contribution;
+            count = 1;
+        }
+    }
+
+    bool grows() const {
+        const double eps = std::numeric_limits<double>::epsilon();
+        return count == 2 && moment[1] > 0.0 && moment[1] >= moment[0] * (1.0 - 16.0 * eps);
+    }
+};
+
+} // namespace detail
+
+// Результат метода tanh-sinh
+struct tanh_sinh_result {
+    double value;              // приближённое значение интеграла
+    double error;              // разность двух последних уровней или хвост у концов
+    std::int64_t evaluations;  // число вычислений функции
+    int levels;                // число использованных уровней
+    bool converged;            // достигнута ли требуемая точность
+    bool diverged;             // суммы не ограничены: интеграл расходится
+};
+
+template <typename Function>
+tanh_sinh_result tanh_sinh(Function f, double a, double b, double abs_tol, double rel_tol = 0.0,
+                           int max_levels = tanh_sinh_table::max_levels) {
+    INTEGRATION_RULE_SCOPE("tanh_sinh");
+    const tanh_sinh_table& table = tanh_sinh_table::instance();
+    const double half_pi = 2.0 * std::atan(1.0);
+    const double center = 0.5 * (a + b);
+    const double half = 0.5 * (b - a);
+    max_levels = std::min(max_levels, tanh_sinh_table::max_levels);
+
+    tanh_sinh_result result{0.0, std::numeric_limits<double>::infinity(), 1, 0, false, false};
+    double sum = half_pi * detail::call_with_offset(f, center, center - a);
+    // Самые близкие к концам узлы по всем уровням: их вклад - оценка
+    // отброшенного хвоста
+    detail::edge_trend outer_left, outer_right;
+    double previous = 0.0;
+
+    for (int level = 0; level < max_levels; level++) {
+        const std::vector<tanh_sinh_node>& nodes = table.level(level);
+        // Узлы, совпавшие с концом отрезка в арифметике double, пропускаем,
+        // если только функция не получает точное смещение от конца
+        detail::edge_trend trend_left, trend_right;
+        for (std::size_t i = 0; i < nodes.size(); i++) {
+            double distance = half * nodes[i].complement;
+            double left = a + distance;
+            double right = b - distance;
+            if (detail::takes_offset<Function> || left > a) {
+                double value = detail::call_with_offset(f, left, distance);
+                sum += nodes[i].weight * value;
+                result.evaluations++;
+                trend_left.add(detail::takes_offset<Function> ? distance : left - a, value,
+                               nodes[i].weight * value);
+            }
+            if (detail::takes_offset<Function> || right < b) {
+                double value = detail::call_with_offset(f, right, -distance);
+                sum += nodes[i].weight * value;
+                result.evaluations++;
+                trend_right.add(detail::takes_offset<Function> ? distance : b - right, value,
+                                nodes[i].weight * value);
+            }
+        }
+        outer_left.merge(trend_left);
+        outer_right.merge(trend_right);
+
+        double h = std::ldexp(1.0, -level);
+        double estimate = h * half * sum;
+        result.value = estimate;
+        result.levels = level + 1;
+
+        // Вклад узлов не убывает при приближении к концу - интеграл расходится
+        if (!std::isfinite(estimate) || trend_left.grows() || trend_right.grows()) {
+            result.diverged = true;
+            result.error = std::numeric_limits<double>::infinity();
+            break;
+        }
+        if (level > 0) {
+            // Кроме разности уровней - хвост за самыми близкими к концам узлами
+            double tail =
+                std::max(std::abs(outer_left.contribution), std::abs(outer_right.contribution));
+            result.error = std::max(std::abs(estimate - previous), half * tail);
+            if (level >= 2 && result.error <= std::max(abs_tol, rel_tol * std::abs(estimate))) {
+                result.converged = true;
+                break;
+            }
+        }
+        previous = estimate;
+    }
+    INTEGRATION_COUNT_EVALUATIONS(result.evaluations);
+    return result;
+}
+
+} // namespace integration
+
+#endif // TANH_SINH_H
@@ -0,0 +1,195 @@
+#ifndef THREAD_POOL_H
+#define THREAD_POOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Пул потоков с перехватом работы (work stealing).
+// У каждого рабочего потока своя очередь: свои задачи он берёт с конца,
+// а когда очередь пуста - забирает задачи с начала чужих очередей.
+// Поток, ожидающий завершения группы задач, тоже выполняет задачи,
+// поэтому пул на threads потоков создаёт threads - 1 рабочих потоков.
+
+namespace integration {
+
+class thread_pool {
+public:
+    using task = std::function<void()>;
+
+    explicit thread_pool(unsigned threads) {
+        if (threads == 0) {
+            threads = 1;
+        }
+        queues_.resize(threads);
+        for (auto& queue : queues_) {
+            queue = std::make_unique<worker_queue>();
+        }
+        // Очередь 0 принадлежит внешним (вызывающим) потокам
+        for (unsigned i = 1; i < threads; i++) {
+            workers_.emplace_back([this, i] { worker_loop(i); });
+        }
+    }
+
+    ~thread_pool() {
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            stop_ = true;
+        }
+        wake_.notify_all();
+        for (auto& worker : workers_) {
+            worker.join();
+        }
+    }
+
+    thread_pool(const thread_pool&) = delete;
+    thread_pool& operator=(const thread_pool&) = delete;
+
+    // Общее число потоков, включая вызывающий
+    unsigned size() const { return static_cast<unsigned>(queues_.size()); }
+
+    // Поставить задачу в очередь текущего рабочего потока (или в общую очередь 0)
+    void submit(task job) {
+        unsigned index = current_index();
+        {
+            std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+            queues_[index]->tasks.push_back(std::move(job));
+        }
+        {
+            std::lock_guard<std::mutex> lock(sleep_mutex_);
+            pending_++;
+        }
+        wake_.notify_one();
+    }
+
+    // Выполнить одну задачу, если она есть; используется ожидающим потоком
+    bool run_one() {
+        task job;
+        if (!take(current_index(), job)) {
+            return false;
+        }
+        job();
+        return true;
+    }
+
+private:
+    struct worker_queue {
+        std::mutex mutex;
+        std::deque<task> tasks;
+    };
+
+    static unsigned& thread_index() {
+        static thread_local unsigned index = 0;
+        return index;
+    }
+
+    // Индекс очереди текущего потока; внешние потоки работают с очередью 0
+    unsigned current_index() const {
+        unsigned index = thread_index();
+        return (index < queues_.size() && owner_ == this) ? index : 0;
+    }
+
+    // Своя задача с конца очереди, иначе перехват с начала чужой очереди
+    bool take(unsigned index, task& job) {
+        {
+            std::lock_guard<std::mutex> lock(queues_[index]->mutex);
+            if (!queues_[index]->tasks.empty()) {
+                job = std::move(queues_[index]->tasks.back());
+                queues_[index]->tasks.pop_back();
+                pending_--;
+                return true;
+            }
+        }
+        for (std::size_t k = 1; k < queues_.size(); k++) {
+            worker_queue& victim = *queues_[(index + k) % queues_.size()];
+            std::lock_guard<std::mutex> lock(victim.mutex);
+            if (!victim.tasks.empty()) {
+                job = std::move(victim.tasks.front());
+                victim.tasks.pop_front();
+                pending_--;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void worker_loop(unsigned index) {
+        thread_index() = index;
+        owner_ = this;
+        for (;;) {
+            task job;
+            if (take(index, job)) {
+                job();
+                continue;
+            }
+            std::unique_lock<std::mutex> lock(sleep_mutex_);
+            wake_.wait(lock, [this] { return stop_ || pending_ > 0; });
+            if (stop_ && pending_ == 0) {
+                return;
+            }
+        }
+    }
+
+    static thread_local const thread_pool* owner_;
+
+    std::vector<std::unique_ptr<worker_queue>> queues_;
+    std::vector<std::thread> workers_;
+    std::mutex sleep_mutex_;
+    std::condition_variable wake_;
+    std::atomic<std::int64_t> pending_{0};
+    bool stop_ = false;
+};
+
+inline thread_local const thread_pool* thread_pool::owner_ = nullptr;
+
+// Число потоков по умолчанию: переменная окружения INTEGRATION_THREADS
+// или число аппаратных потоков
+inline unsigned default_thread_count() {
+    if (const char* env = std::getenv("INTEGRATION_THREADS")) {
+        int threads = std::atoi(env);
+        if (threads > 0) {
+            return static_cast<unsigned>(threads);
+        }
+    }
+    unsigned threads = std::thread::hardware_concurrency();
+    return threads > 0 ? threads : 1;
+}
+
+// Общий пул, создаётся при первом обращении
+inline thread_pool& default_pool() {
+    static thread_pool pool(default_thread_count());
+    return pool;
+}
+
+// Выполнить body(0) .. body(chunks - 1) в пуле; вызывающий поток участвует в работе
+template <typename Body>
+void parallel_for(thread_pool& pool, std::int64_t chunks, Body&& body) {
+    if (chunks <= 0) {
+        return;
+    }
+    std::atomic<std::int64_t> remaining{chunks};
+    for (std::int64_t c = chunks - 1; c > 0; c--) {
+        pool.submit([&body, &remaining, c] {
+            body(c);
+            remaining--;
+        });
+    }
+    body(0);
+    remaining--;
+    while (remaining.load() > 0) {
+        if (!pool.run_one()) {
+            std::this_thread::yield();
+        }
+    }
+}
+
+} // namespace integration
+
+#endif // THREAD_POOL_H
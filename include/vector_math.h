@@ -0,0 +1,574 @@
+#ifndef VECTOR_MATH_H
+#define VECTOR_MATH_H
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+
+#include "simd.h"
+
+// Векторные sin, cos, exp, log, sqrt и pow над массивами double:
+//   integration::vmath::sin(x, y, n);   // y[i] = sin(x[i])
+// Значения считаются полиномами (коэффициенты fdlibm для sin, cos и log,
+// ряд Тейлора до x^13 для exp) сразу в 4 (AVX2 + FMA) или 8 (AVX-512)
+// дорожках; ядро выбирается один раз по возможностям процессора, как в
+// simd.h. Аргументы вне основной области (|x| > 1e5 у sin и cos, |x| > 708
+// у exp, x <= 0 или денормализованные у log, inf и NaN) досчитываются
+// скалярной библиотекой, так что особые случаи совпадают с <cmath>.
+//
+// Погрешность относительно точного значения (проверено на 10^7 случайных
+// аргументов против long double, в том числе вблизи кратных pi/2):
+//   sin, cos  - менее 1 ulp (|x| <= 1e5; pi/2 хранится четырьмя частями)
+//   exp       - менее 1 ulp
+//   log       - менее 1 ulp
+//   sqrt      - 0.5 ulp (аппаратный корень, правильное округление)
+//   pow(x, y) - exp(y log x): не более 1 + 4 |y ln x| ulp, так как
+//               округление y log x усиливается экспонентой
+// Без SIMD (INTEGRATION_NO_SIMD или не x86) все функции - циклы по <cmath>.
+
+namespace integration {
+namespace vmath {
+
+// Размер блока, которым функторы из function.h вычисляют узлы
+constexpr int block = 64;
+
+namespace detail {
+
+using unary_kernel = void (*)(const double* x, double* y, std::size_t count);
+using binary_kernel = void (*)(const double* x, const double* p, double* y, std::size_t count);
+
+struct kernels {
+    unary_kernel sin, cos, exp, log, sqrt;
+    binary_kernel pow;
+    const char* name;
+};
+
+// Скалярные ядра: <cmath>
+inline void sin_scalar(const double* x, double* y, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) y[i] = std::sin(x[i]);
+}
+inline void cos_scalar(const double* x, double* y, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) y[i] = std::cos(x[i]);
+}
+inline void exp_scalar(const double* x, double* y, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) y[i] = std::exp(x[i]);
+}
+inline void log_scalar(const double* x, double* y, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) y[i] = std::log(x[i]);
+}
+inline void sqrt_scalar(const double* x, double* y, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) y[i] = std::sqrt(x[i]);
+}
+inline void pow_scalar(const double* x, const double* p, double* y, std::size_t count) {
+    for (std::size_t i = 0; i < count; i++) y[i] = std::pow(x[i], p[i]);
+}
+
+// Константы полиномов
+constexpr double two_over_pi = 6.36619772367581382433e-01;
+constexpr double pio2_1 = 1.57079632673412561417e+00;  // первые 33 бита pi/2
+constexpr double pio2_2 = 6.07710050630396597660e-11;  // следующие 33 бита
+constexpr double pio2_3 = 2.02226624871116645580e-21;  // ещё 33 бита
+constexpr double pio2_4 = 8.47842766036889956997e-32;  // остаток
+constexpr double trig_limit = 1e5;
+
+constexpr double sin_c[] = {-1.66666666666666324348e-01, 8.33333333332248946124e-03,
+                            -1.98412698298579493134e-04, 2.75573137070700676789e-06,
+                            -2.50507602534068634195e-08, 1.58969099521155010221e-10};
+constexpr double cos_c[] = {4.16666666666666019037e-02, -1.38888888888741095749e-03,
+                            2.48015872894767294178e-05, -2.75573143513906633035e-07,
+                            2.08757232129817482790e-09, -1.13596475577881948265e-11};
+
+constexpr double inv_ln2 = 1.44269504088896338700e+00;
+constexpr double ln2_hi = 6.93147180369123816490e-01;
+constexpr double ln2_lo = 1.90821492927058770002e-10;
+constexpr double exp_limit = 708.0;
+
+constexpr double log_c[] = {6.666666666666735130e-01, 3.999999999940941908e-01,
+                            2.857142874366239149e-01, 2.222219843214978396e-01,
+                            1.818357216161805012e-01, 1.531383769920937332e-01,
+                            1.479819860511658591e-01};
+constexpr double sqrt2 = 1.41421356237309504880;
+constexpr double min_normal = 2.2250738585072014e-308;
+constexpr double max_finite = 1.7976931348623157e308;
+
+// 1.5 * 2^52: после прибавления число округлено до целого, и это целое
+// (|k| < 2^51) лежит в младших битах мантиссы в дополнительном коде
+constexpr double magic = 6755399441055744.0;
+
+#ifdef INTEGRATION_X86_SIMD
+
+// ---------- AVX2 + FMA: 4 дорожки ----------
+
+// Полином по схеме Горнера
+template <int N>
+__attribute__((target("avx2,fma"))) inline __m256d horner_avx2(__m256d z, const double (&c)[N]) {
+    __m256d r = _mm256_set1_pd(c[N - 1]);
+    for (int i = N - 2; i >= 0; i--) {
+        r = _mm256_fmadd_pd(r, z, _mm256_set1_pd(c[i]));
+    }
+    return r;
+}
+
+// sin (cosine = false) или cos; outside - дорожки вне основной области
+__attribute__((target("avx2,fma"))) inline __m256d
+sin_cos_lanes_avx2(__m256d x, bool cosine, __m256d& outside) {
+    const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    __m256d ax = _mm256_and_pd(x, abs_mask);
+    outside = _mm256_cmp_pd(ax, _mm256_set1_pd(trig_limit), _CMP_NLE_UQ);
+    x = _mm256_andnot_pd(outside, x);
+
+    // x = k pi/2 + r, |r| <= pi/4
+    __m256d shifted = _mm256_fmadd_pd(x, _mm256_set1_pd(two_over_pi), _mm256_set1_pd(magic));
+    __m256d k = _mm256_sub_pd(shifted, _mm256_set1_pd(magic));
+    // r = r_hi + r_lo: при вычитании k pi/2 теряются старшие биты, поэтому
+    // ошибка округления r_hi сохраняется в r_lo
+    __m256d a = _mm256_fnmadd_pd(k, _mm256_set1_pd(pio2_1), x);
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(pio2_2), a);
+    __m256d r_lo = _mm256_fnmadd_pd(k, _mm256_set1_pd(pio2_2), _mm256_sub_pd(a, r));
+    r_lo = _mm256_fnmadd_pd(k, _mm256_set1_pd(pio2_3), r_lo);
+    r_lo = _mm256_fnmadd_pd(k, _mm256_set1_pd(pio2_4), r_lo);
+    __m256i quadrant = _mm256_castpd_si256(shifted);
+    if (cosine) {
+        quadrant = _mm256_add_epi64(quadrant, _mm256_set1_epi64x(1));
+    }
+
+    const __m256d z = _mm256_mul_pd(r, r);
+    const __m256d one = _mm256_set1_pd(1.0);
+    __m256d hz = _mm256_mul_pd(_mm256_set1_pd(0.5), z);
+    // sin(r + r_lo) = r + (r^3 (S1 + z S2 + ...) + r_lo (1 - z/2))
+    __m256d s = _mm256_add_pd(r, _mm256_fmadd_pd(_mm256_mul_pd(z, r), horner_avx2(z, sin_c),
+                                                 _mm256_mul_pd(r_lo, _mm256_sub_pd(one, hz))));
+    // cos(r + r_lo) = 1 - z/2 + (z^2 (C1 + ...) - r r_lo), с поправкой
+    // округления 1 - z/2 как в fdlibm
+    __m256d w = _mm256_sub_pd(one, hz);
+    __m256d tail = _mm256_fmsub_pd(_mm256_mul_pd(z, z), horner_avx2(z, cos_c),
+                                   _mm256_mul_pd(r, r_lo));
+    __m256d c = _mm256_add_pd(w, _mm256_add_pd(_mm256_sub_pd(_mm256_sub_pd(one, w), hz), tail));
+
+    // Чётверть: 0 -> sin, 1 -> cos, 2 -> -sin, 3 -> -cos
+    __m256i bit0 = _mm256_and_si256(quadrant, _mm256_set1_epi64x(1));
+    __m256d use_cos = _mm256_castsi256_pd(_mm256_cmpeq_epi64(bit0, _mm256_set1_epi64x(1)));
+    __m256d result = _mm256_blendv_pd(s, c, use_cos);
+    __m256i sign = _mm256_slli_epi64(_mm256_and_si256(quadrant, _mm256_set1_epi64x(2)), 62);
+    return _mm256_xor_pd(result, _mm256_castsi256_pd(sign));
+}
+
+__attribute__((target("avx2,fma"))) inline __m256d exp_lanes_avx2(__m256d x, __m256d& outside) {
+    const __m256d abs_mask = _mm256_castsi256_pd(_mm256_set1_epi64x(0x7fffffffffffffffLL));
+    outside = _mm256_cmp_pd(_mm256_and_pd(x, abs_mask), _mm256_set1_pd(exp_limit), _CMP_NLE_UQ);
+    x = _mm256_andnot_pd(outside, x);
+
+    // x = k ln2 + r, |r| <= ln2 / 2
+    __m256d k = _mm256_sub_pd(_mm256_fmadd_pd(x, _mm256_set1_pd(inv_ln2), _mm256_set1_pd(magic)),
+                              _mm256_set1_pd(magic));
+    __m256d r = _mm256_fnmadd_pd(k, _mm256_set1_pd(ln2_hi), x);
+    r = _mm256_fnmadd_pd(k, _mm256_set1_pd(ln2_lo), r);
+
+    // e^r - 1 = r + r^2 (1/2! + r/3! + ... + r^11/13!)
+    static constexpr double c[] = {1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120, 1.0 / 720,
+                                   1.0 / 5040, 1.0 / 40320, 1.0 / 362880, 1.0 / 3628800,
+                                   1.0 / 39916800, 1.0 / 479001600, 1.0 / 6227020800.0};
+    __m256d p = _mm256_fmadd_pd(_mm256_mul_pd(r, r), horner_avx2(r, c), r);
+    __m256d e = _mm256_add_pd(_mm256_set1_pd(1.0), p);
+
+    // 2^k: k + 1023 в поле порядка
+    __m256i bits = _mm256_castpd_si256(_mm256_add_pd(k, _mm256_set1_pd(magic + 1023.0)));
+    __m256d scale = _mm256_castsi256_pd(_mm256_slli_epi64(bits, 52));
+    return _mm256_mul_pd(e, scale);
+}
+
+__attribute__((target("avx2,fma"))) inline __m256d log_lanes_avx2(__m256d x, __m256d& outside) {
+    __m256d normal = _mm256_and_pd(_mm256_cmp_pd(x, _mm256_set1_pd(min_normal), _CMP_GE_OQ),
+                                   _mm256_cmp_pd(x, _mm256_set1_pd(max_finite), _CMP_LE_OQ));
+    outside = _mm256_xor_pd(normal, _mm256_castsi256_pd(_mm256_set1_epi64x(-1)));
+    x = _mm256_blendv_pd(_mm256_set1_pd(1.0), x, normal);
+
+    // x = 2^k m, m в [sqrt2/2, sqrt2)
+    __m256i bits = _mm256_castpd_si256(x);
+    __m256i exponent = _mm256_srli_epi64(bits, 52);
+    __m256d k = _mm256_sub_pd(
+        _mm256_castsi256_pd(_mm256_or_si256(exponent, _mm256_castpd_si256(_mm256_set1_pd(magic)))),
+        _mm256_set1_pd(magic + 1023.0));
+    __m256i mantissa = _mm256_and_si256(bits, _mm256_set1_epi64x(0x000fffffffffffffLL));
+    __m256d m = _mm256_castsi256_pd(
+        _mm256_or_si256(mantissa, _mm256_castpd_si256(_mm256_set1_pd(1.0))));
+    __m256d large = _mm256_cmp_pd(m, _mm256_set1_pd(sqrt2), _CMP_GT_OQ);
+    m = _mm256_blendv_pd(m, _mm256_mul_pd(m, _mm256_set1_pd(0.5)), large);
+    k = _mm256_add_pd(k, _mm256_and_pd(large, _mm256_set1_pd(1.0)));
+
+    // log m = f - f^2/2 + s (f^2/2 + R(s^2)), s = f / (2 + f) - формула fdlibm
+    __m256d f = _mm256_sub_pd(m, _mm256_set1_pd(1.0));
+    __m256d s = _mm256_div_pd(f, _mm256_add_pd(_mm256_set1_pd(2.0), f));
+    __m256d z = _mm256_mul_pd(s, s);
+    __m256d R = _mm256_mul_pd(z, horner_avx2(z, log_c));
+    __m256d hfsq = _mm256_mul_pd(_mm256_set1_pd(0.5), _mm256_mul_pd(f, f));
+    __m256d tail = _mm256_fmadd_pd(s, _mm256_add_pd(hfsq, R),
+                                   _mm256_mul_pd(k, _mm256_set1_pd(ln2_lo)));
+    return _mm256_fmsub_pd(k, _mm256_set1_pd(ln2_hi),
+                           _mm256_sub_pd(_mm256_sub_pd(hfsq, tail), f));
+}
+
+// Функции вида y = op(x) по массиву: полные векторы, хвост - через буфер,
+// дорожки вне области - скалярно
+struct sin_avx2_op {
+    __attribute__((target("avx2,fma"))) static __m256d vector(__m256d x, __m256d& outside) {
+        return sin_cos_lanes_avx2(x, false, outside);
+    }
+    static double scalar(double x) { return std::sin(x); }
+};
+struct cos_avx2_op {
+    __attribute__((target("avx2,fma"))) static __m256d vector(__m256d x, __m256d& outside) {
+        return sin_cos_lanes_avx2(x, true, outside);
+    }
+    static double scalar(double x) { return std::cos(x); }
+};
+struct exp_avx2_op {
+    __attribute__((target("avx2,fma"))) static __m256d vector(__m256d x, __m256d& outside) {
+        return exp_lanes_avx2(x, outside);
+    }
+    static double scalar(double x) { return std::exp(x); }
+};
+struct log_avx2_op {
+    __attribute__((target("avx2,fma"))) static __m256d vector(__m256d x, __m256d& outside) {
+        return log_lanes_avx2(x, outside);
+    }
+    static double scalar(double x) { return std::log(x); }
+};
+
+template <typename Op>
+__attribute__((target("avx2,fma"))) inline void
+unary_avx2(const double* x, double* y, std::size_t count) {
+    double in[4], out[4];
+    for (std::size_t i = 0; i < count; i += 4) {
+        std::size_t lanes = std::min<std::size_t>(4, count - i);
+        const double* source = x + i;
+        if (lanes < 4) {
+            std::fill(in, in + 4, 1.0);
+            std::copy(x + i, x + count, in);
+            source = in;
+        }
+        __m256d outside;
+        _mm256_storeu_pd(out, Op::vector(_mm256_loadu_pd(source), outside));
+        int mask = _mm256_movemask_pd(outside);
+        for (std::size_t k = 0; k < lanes; k++) {
+            y[i + k] = (mask >> k) & 1 ? Op::scalar(x[i + k]) : out[k];
+        }
+    }
+}
+
+__attribute__((target("avx2,fma"))) inline void
+sqrt_avx2(const double* x, double* y, std::size_t count) {
+    std::size_t i = 0;
+    for (; i + 4 <= count; i += 4) {
+        _mm256_storeu_pd(y + i, _mm256_sqrt_pd(_mm256_loadu_pd(x + i)));
+    }
+    sqrt_scalar(x + i, y + i, count - i);
+}
+
+// x^p = exp(p log x) при x > 0; остальное - std::pow
+__attribute__((target("avx2,fma"))) inline void
+pow_avx2(const double* x, const double* p, double* y, std::size_t count) {
+    double in[4], power[4], out[4];
+    for (std::size_t i = 0; i < count; i += 4) {
+        std::size_t lanes = std::min<std::size_t>(4, count - i);
+        std::fill(in, in + 4, 1.0);
+        std::fill(power, power + 4, 1.0);
+        std::copy(x + i, x + i + lanes, in);
+        std::copy(p + i, p + i + lanes, power);
+        __m256d bad_log, bad_exp;
+        __m256d t = _mm256_mul_pd(_mm256_loadu_pd(power),
+                                  log_lanes_avx2(_mm256_loadu_pd(in), bad_log));
+        _mm256_storeu_pd(out, exp_lanes_avx2(t, bad_exp));
+        int mask = _mm256_movemask_pd(_mm256_or_pd(bad_log, bad_exp));
+        for (std::size_t k = 0; k < lanes; k++) {
+            y[i + k] = (mask >> k) & 1 ? std::pow(x[i + k], p[i + k]) : out[k];
+        }
+    }
+}
+
+inline void sin_avx2(const double* x, double* y, std::size_t count) {
+    unary_avx2<sin_avx2_op>(x, y, count);
+}
+inline void cos_avx2(const double* x, double* y, std::size_t count) {
+    unary_avx2<cos_avx2_op>(x, y, count);
+}
+inline void exp_avx2(const double* x, double* y, std::size_t count) {
+    unary_avx2<exp_avx2_op>(x, y, count);
+}
+inline void log_avx2(const double* x, double* y, std::size_t count) {
+    unary_avx2<log_avx2_op>(x, y, count);
+}
+
+// ---------- AVX-512: 8 дорожек ----------
+
+template <int N>
+__attribute__((target("avx512f"))) inline __m512d horner_avx512(__m512d z, const double (&c)[N]) {
+    __m512d r = _mm512_set1_pd(c[N - 1]);
+    for (int i = N - 2; i >= 0; i--) {
+        r = _mm512_fmadd_pd(r, z, _mm512_set1_pd(c[i]));
+    }
+    return r;
+}
+
+__attribute__((target("avx512f"))) inline __m512d
+sin_cos_lanes_avx512(__m512d x, bool cosine, __mmask8& outside) {
+    outside = _mm512_cmp_pd_mask(_mm512_abs_pd(x), _mm512_set1_pd(trig_limit), _CMP_NLE_UQ);
+    x = _mm512_mask_blend_pd(outside, x, _mm512_setzero_pd());
+
+    __m512d shifted = _mm512_fmadd_pd(x, _mm512_set1_pd(two_over_pi), _mm512_set1_pd(magic));
+    __m512d k = _mm512_sub_pd(shifted, _mm512_set1_pd(magic));
+    // r = r_hi + r_lo: при вычитании k pi/2 теряются старшие биты, поэтому
+    // ошибка округления r_hi сохраняется в r_lo
+    __m512d a = _mm512_fnmadd_pd(k, _mm512_set1_pd(pio2_1), x);
+    __m512d r = _mm512_fnmadd_pd(k, _mm512_set1_pd(pio2_2), a);
+    __m512d r_lo = _mm512_fnmadd_pd(k, _mm512_set1_pd(pio2_2), _mm512_sub_pd(a, r));
+    r_lo = _mm512_fnmadd_pd(k, _mm512_set1_pd(pio2_3), r_lo);
+    r_lo = _mm512_fnmadd_pd(k, _mm512_set1_pd(pio2_4), r_lo);
+    __m512i quadrant = _mm512_castpd_si512(shifted);
+    if (cosine) {
+        quadrant = _mm512_add_epi64(quadrant, _mm512_set1_epi64(1));
+    }
+
+    const __m512d z = _mm512_mul_pd(r, r);
+    const __m512d one = _mm512_set1_pd(1.0);
+    __m512d hz = _mm512_mul_pd(_mm512_set1_pd(0.5), z);
+    __m512d s = _mm512_add_pd(r, _mm512_fmadd_pd(_mm512_mul_pd(z, r), horner_avx512(z, sin_c),
+                                                 _mm512_mul_pd(r_lo, _mm512_sub_pd(one, hz))));
+    __m512d w = _mm512_sub_pd(one, hz);
+    __m512d tail = _mm512_fmsub_pd(_mm512_mul_pd(z, z), horner_avx512(z, cos_c),
+                                   _mm512_mul_pd(r, r_lo));
+    __m512d c = _mm512_add_pd(w, _mm512_add_pd(_mm512_sub_pd(_mm512_sub_pd(one, w), hz), tail));
+
+    __mmask8 use_cos = _mm512_test_epi64_mask(quadrant, _mm512_set1_epi64(1));
+    __mmask8 negative = _mm512_test_epi64_mask(quadrant, _mm512_set1_epi64(2));
+    __m512i result = _mm512_castpd_si512(_mm512_mask_blend_pd(use_cos, s, c));
+    return _mm512_castsi512_pd(_mm512_mask_xor_epi64(result, negative, result,
+                                                     _mm512_set1_epi64(INT64_MIN)));
+}
+
+__attribute__((target("avx512f"))) inline __m512d exp_lanes_avx512(__m512d x, __mmask8& outside) {
+    outside = _mm512_cmp_pd_mask(_mm512_abs_pd(x), _mm512_set1_pd(exp_limit), _CMP_NLE_UQ);
+    x = _mm512_mask_blend_pd(outside, x, _mm512_setzero_pd());
+
+    __m512d k = _mm512_sub_pd(_mm512_fmadd_pd(x, _mm512_set1_pd(inv_ln2), _mm512_set1_pd(magic)),
+                              _mm512_set1_pd(magic));
+    __m512d r = _mm512_fnmadd_pd(k, _mm512_set1_pd(ln2_hi), x);
+    r = _mm512_fnmadd_pd(k, _mm512_set1_pd(ln2_lo), r);
+
+    static constexpr double c[] = {1.0 / 2, 1.0 / 6, 1.0 / 24, 1.0 / 120, 1.0 / 720,
+                                   1.0 / 5040, 1.0 / 40320, 1.0 / 362880, 1.0 / 3628800,
+                                   1.0 / 39916800, 1.0 / 479001600, 1.0 / 6227020800.0};
+    __m512d p = _mm512_fmadd_pd(_mm512_mul_pd(r, r), horner_avx512(r, c), r);
+    __m512d e = _mm512_add_pd(_mm512_set1_pd(1.0), p);
+
+    __m512i bits = _mm512_castpd_si512(_mm512_add_pd(k, _mm512_set1_pd(magic + 1023.0)));
+    __m512d scale = _mm512_castsi512_pd(
+        _mm512_maskz_slli_epi64(static_cast<__mmask8>(~outside), bits, 52));
+    return _mm512_mul_pd(e, scale);
+}
+
+__attribute__((target("avx512f"))) inline __m512d log_lanes_avx512(__m512d x, __mmask8& outside) {
+    __mmask8 normal = _mm512_cmp_pd_mask(x, _mm512_set1_pd(min_normal), _CMP_GE_OQ) &
+                      _mm512_cmp_pd_mask(x, _mm512_set1_pd(max_finite), _CMP_LE_OQ);
+    outside = static_cast<__mmask8>(~normal);
+
+    // Порядок и мантисса в [1, 2) - отдельными командами AVX-512; в дорожках
+    // вне области x = 1 (k = 0, m = 1)
+    __m512d k = _mm512_mask_getexp_pd(_mm512_setzero_pd(), normal, x);
+    __m512d m = _mm512_mask_getmant_pd(_mm512_set1_pd(1.0), normal, x, _MM_MANT_NORM_1_2,
+                                       _MM_MANT_SIGN_zero);
+    __mmask8 large = _mm512_cmp_pd_mask(m, _mm512_set1_pd(sqrt2), _CMP_GT_OQ);
+    m = _mm512_mask_mul_pd(m, large, m, _mm512_set1_pd(0.5));
+    k = _mm512_mask_add_pd(k, large, k, _mm512_set1_pd(1.0));
+
+    __m512d f = _mm512_sub_pd(m, _mm512_set1_pd(1.0));
+    __m512d s = _mm512_div_pd(f, _mm512_add_pd(_mm512_set1_pd(2.0), f));
+    __m512d z = _mm512_mul_pd(s, s);
+    __m512d R = _mm512_mul_pd(z, horner_avx512(z, log_c));
+    __m512d hfsq = _mm512_mul_pd(_mm512_set1_pd(0.5), _mm512_mul_pd(f, f));
+    __m512d tail = _mm512_fmadd_pd(s, _mm512_add_pd(hfsq, R),
+                                   _mm512_mul_pd(k, _mm512_set1_pd(ln2_lo)));
+    return _mm512_fmsub_pd(k, _mm512_set1_pd(ln2_hi),
+                           _mm512_sub_pd(_mm512_sub_pd(hfsq, tail), f));
+}
+
+struct sin_avx512_op {
+    __attribute__((target("avx512f"))) static __m512d vector(__m512d x, __mmask8& outside) {
+        return sin_cos_lanes_avx512(x, false, outside);
+    }
+    static double scalar(double x) { return std::sin(x); }
+};
+struct cos_avx512_op {
+    __attribute__((target("avx512f"))) static __m512d vector(__m512d x, __mmask8& outside) {
+        return sin_cos_lanes_avx512(x, true, outside);
+    }
+    static double scalar(double x) { return std::cos(x); }
+};
+struct exp_avx512_op {
+    __attribute__((target("avx512f"))) static __m512d vector(__m512d x, __mmask8& outside) {
+        return exp_lanes_avx512(x, outside);
+    }
+    static double scalar(double x) { return std::exp(x); }
+};
+struct log_avx512_op {
+    __attribute__((target("avx512f"))) static __m512d vector(__m512d x, __mmask8& outside) {
+        return log_lanes_avx512(x, outside);
+    }
+    static double scalar(double x) { return std::log(x); }
+};
+
+// Хвост загружается и сохраняется маской
+template <typename Op>
+__attribute__((target("avx512f"))) inline void
+unary_avx512(const double* x, double* y, std::size_t count) {
+    for (std::size_t i = 0; i < count; i += 8) {
+        std::size_t lanes = std::min<std::size_t>(8, count - i);
+        __mmask8 active = static_cast<__mmask8>((1u << lanes) - 1);
+        __m512d v = _mm512_mask_loadu_pd(_mm512_set1_pd(1.0), active, x + i);
+        __mmask8 outside;
+        __m512d result = Op::vector(v, outside);
+        outside &= active;
+        if (!outside) {
+            _mm512_mask_storeu_pd(y + i, active, result);
+            continue;
+        }
+        // Скалярные дорожки читают x до записи y (x и y могут совпадать)
+        double out[8];
+        _mm512_storeu_pd(out, result);
+        for (std::size_t k = 0; k < lanes; k++) {
+            y[i + k] = (outside >> k) & 1 ? Op::scalar(x[i + k]) : out[k];
+        }
+    }
+}
+
+__attribute__((target("avx512f"))) inline void
+sqrt_avx512(const double* x, double* y, std::size_t count) {
+    for (std::size_t i = 0; i < count; i += 8) {
+        std::size_t lanes = std::min<std::size_t>(8, count - i);
+        __mmask8 active = static_cast<__mmask8>((1u << lanes) - 1);
+        __m512d v = _mm512_mask_loadu_pd(_mm512_set1_pd(1.0), active, x + i);
+        _mm512_mask_storeu_pd(y + i, active, _mm512_mask_sqrt_pd(v, active, v));
+    }
+}
+
+__attribute__((target("avx512f"))) inline void
+pow_avx512(const double* x, const double* p, double* y, std::size_t count) {
+    for (std::size_t i = 0; i < count; i += 8) {
+        std::size_t lanes = std::min<std::size_t>(8, count - i);
+        __mmask8 active = static_cast<__mmask8>((1u << lanes) - 1);
+        __m512d v = _mm512_mask_loadu_pd(_mm512_set1_pd(1.0), active, x + i);
+        __m512d power = _mm512_mask_loadu_pd(_mm512_set1_pd(1.0), active, p + i);
+        __mmask8 bad_log, bad_exp;
+        __m512d t = _mm512_mul_pd(power, log_lanes_avx512(v, bad_log));
+        __m512d result = exp_lanes_avx512(t, bad_exp);
+        __mmask8 outside = static_cast<__mmask8>((bad_log | bad_exp) & active);
+        if (!outside) {
+            _mm512_mask_storeu_pd(y + i, active, result);
+            continue;
+        }
+        double out[8];
+        _mm512_storeu_pd(out, result);
+        for (std::size_t k = 0; k < lanes; k++) {
+            y[i + k] = (outside >> k) & 1 ? std::pow(x[i + k], p[i + k]) : out[k];
+        }
+    }
+}
+
+inline void sin_avx512(const double* x, double* y, std::size_t count) {
+    unary_avx512<sin_avx512_op>(x, y, count);
+}
+inline void cos_avx512(const double* x, double* y, std::size_t count) {
+    unary_avx512<cos_avx512_op>(x, y, count);
+}
+inline void exp_avx512(const double* x, double* y, std::size_t count) {
+    unary_avx512<exp_avx512_op>(x, y, count);
+}
+inline void log_avx512(const double* x, double* y, std::size_t count) {
+    unary_avx512<log_avx512_op>(x, y, count);
+}
+
+#endif // INTEGRATION_X86_SIMD
+
+// Выбор ядер по возможностям процессора
+inline kernels select_kernels() {
+#ifdef INTEGRATION_X86_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return {sin_avx512, cos_avx512, exp_avx512, log_avx512, sqrt_avx512, pow_avx512, "avx512"};
+    }
+    if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+        return {sin_avx2, cos_avx2, exp_avx2, log_avx2, sqrt_avx2, pow_avx2, "avx2"};
+    }
+#endif
+    return {sin_scalar, cos_scalar, exp_scalar, log_scalar, sqrt_scalar, pow_scalar, "scalar"};
+}
+
+inline const kernels& active_kernels() {
+    static const kernels selected = select_kernels();
+    return selected;
+}
+
+} // namespace detail
+
+// y[i] = f(x[i]), i < count; x и y могут совпадать
+inline void sin(const double* x, double* y, std::size_t count) {
+    detail::active_kernels().sin(x, y, count);
+}
+inline void cos(const double* x, double* y, std::size_t count) {
+    detail::active_kernels().cos(x, y, count);
+}
+inline void exp(const double* x, double* y, std::size_t count) {
+    detail::active_kernels().exp(x, y, count);
+}
+inline void log(const double* x, double* y, std::size_t count) {
+    detail::active_kernels().log(x, y, count);
+}
+inline void sqrt(const double* x, double* y, std::size_t count) {
+    detail::active_kernels().sqrt(x, y, count);
+}
+
+// y[i] = x[i]^p[i]
+inline void pow(const double* x, const double* p, double* y, std::size_t count) {
+    detail::active_kernels().pow(x, p, y, count);
+}
+
+// Имя выбранного набора ядер (для диагностики)
+inline const char* kernel_name() { return detail::active_kernels().name; }
+
+// Сумма f по узлам start + (i + offset) * step, i = first, first + stride, ... < last:
+// узлы собираются блоками по block значений, evaluate(x, y, count) вычисляет
+// f для блока (обычно через функции выше). Используется в sum_nodes функторов.
+template <typename Evaluate>
+double sum_nodes(double start, double step, double offset, int first, int last, int stride,
+                 Evaluate&& evaluate) {
+    double x[block], y[block];
+    double partial[block] = {};
+    int i = first;
+    while (i < last) {
+        int lanes = 0;
+        if (stride == 1 && last - i >= block) {
+            for (; lanes < block; lanes++) {
+                x[lanes] = start + (i + lanes + offset) * step;
+            }
+            i += block;
+        }
+        for (; lanes < block && i < last; lanes++, i += stride) {
+            x[lanes] = start + (i + offset) * step;
+        }
+        evaluate(x, y, static_cast<std::size_t>(lanes));
+        for (int k = 0; k < lanes; k++) {
+            partial[k] += y[k];
+        }
+    }
+    double total = 0.0;
+    for (double value : partial) {
+        total += value;
+    }
+    return total;
+}
+
+} // namespace vmath
+} // namespace integration
+
+#endif // VECTOR_MATH_H
@@ -0,0 +1,51 @@
+// Встроенные подынтегральные функции в C-интерфейсе (include/integration_c.h)
+
+#include <cstring>
+
+#include "function.h"
+#include "integration_c.h"
+
+namespace {
+
+const char* const function_names[] = {"rational", "sine", "inverse_root", "secant"};
+
+template <typename Function>
+void evaluate(const Function& f, const double* x, double* y, size_t count) {
+    for (size_t i = 0; i < count; i++) {
+        y[i] = f(x[i]);
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+integration_status integration_function_by_name(const char* name, integration_function* function) {
+    if (!name || !function) {
+        return INTEGRATION_INVALID_ARGUMENT;
+    }
+    for (int i = 0; i < 4; i++) {
+        if (std::strcmp(name, function_names[i]) == 0) {
+            *function = static_cast<integration_function>(i);
+            return INTEGRATION_OK;
+        }
+    }
+    return INTEGRATION_UNKNOWN_FUNCTION;
+}
+
+integration_status integration_evaluate(integration_function function, const double* x,
+                                        double* y, size_t count) {
+    if (count > 0 && (!x || !y)) {
+        return INTEGRATION_INVALID_ARGUMENT;
+    }
+    switch (function) {
+    case INTEGRATION_RATIONAL: evaluate(rational_function{}, x, y, count); break;
+    case INTEGRATION_SINE: evaluate(sine_function{}, x, y, count); break;
+    case INTEGRATION_INVERSE_ROOT: evaluate(inverse_root_function{}, x, y, count); break;
+    case INTEGRATION_SECANT: evaluate(secant_function{}, x, y, count); break;
+    default: return INTEGRATION_UNKNOWN_FUNCTION;
+    }
+    return INTEGRATION_OK;
+}
+
+} // extern "C"
@@ -0,0 +1,209 @@
+// Правила интегрирования в C-интерфейсе (include/integration_c.h).
+// Каждое правило конкретизируется здесь для каждой встроенной функции и для
+// функции вызывающей стороны, поэтому встроенные функции сохраняют
+// векторные ядра, а вызывающей стороне не нужны шаблоны.
+
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <new>
+
+#include "function.h"
+#include "gauss_kronrod.h"
+#include "gauss_legendre.h"
+#include "integration.h"
+#include "integration_c.h"
+#include "principal_value.h"
+#include "tanh_sinh.h"
+
+namespace {
+
+const char* const rule_names[] = {"rectangles", "midpoint",      "trapezoid",
+                                  "simpson",    "gauss_legendre", "gauss_kronrod",
+                                  "tanh_sinh",  "cauchy",        "principal_value"};
+
+// Наибольшее число частей (и вычислений у Гаусса-Лежандра): Симпсон
+// добавляет к нечётному n ещё одну часть
+const int64_t max_parts = std::numeric_limits<int>::max() - 1;
+
+// Функция вызывающей стороны с контекстом
+struct callback_function {
+    integration_callback callback;
+    void* context;
+
+    double operator()(double x) const { return callback(x, context); }
+};
+
+// Рабочая память адаптивных правил: одна на поток, выделяется при первом вызове
+integration::gauss_kronrod_workspace& workspace() {
+    static thread_local integration::gauss_kronrod_workspace memory;
+    return memory;
+}
+
+template <typename Result>
+void store_adaptive(const Result& r, integration_result& result) {
+    result.value = r.value;
+    result.error = r.error;
+    result.evaluations = r.evaluations;
+    result.converged = r.converged ? 1 : 0;
+}
+
+template <typename Function>
+integration_status integrate(const Function& f, const integration_request& request,
+                             integration_result& result) {
+    const double a = request.a, b = request.b;
+    const int n = request.n;
+    const integration_rule rule = request.rule;
+    const bool fixed_grid = rule == INTEGRATION_RECTANGLES || rule == INTEGRATION_MIDPOINT ||
+                            rule == INTEGRATION_TRAPEZOID || rule == INTEGRATION_SIMPSON ||
+                            rule == INTEGRATION_GAUSS_LEGENDRE || rule == INTEGRATION_CAUCHY;
+    if ((fixed_grid && (n <= 0 || n > max_parts)) || (!fixed_grid && !(request.tol > 0)) ||
+        (rule == INTEGRATION_GAUSS_LEGENDRE &&
+         (request.order < 1 || request.order > integration::gauss_legendre_max_order ||
+          static_cast<int64_t>(request.order) * n > max_parts)) ||
+        ((rule == INTEGRATION_CAUCHY || rule == INTEGRATION_PRINCIPAL_VALUE) &&
+         std::isnan(request.singularity))) {
+        return INTEGRATION_INVALID_ARGUMENT;
+    }
+
+    result.error = std::numeric_limits<double>::quiet_NaN();
+    result.converged = 1;
+    switch (rule) {
+    case INTEGRATION_RECTANGLES:
+        result.value = integration::rectangles(f, a, b, n);
+        result.evaluations = n;
+        break;
+    case INTEGRATION_MIDPOINT:
+        result.value = integration::midpoint_rule(f, a, b, n);
+        result.evaluations = n;
+        break;
+    case INTEGRATION_TRAPEZOID:
+        result.value = integration::trapezoid(f, a, b, n);
+        result.evaluations = static_cast<int64_t>(n) + 1;
+        break;
+    case INTEGRATION_SIMPSON:
+        result.value = integration::simpson(f, a, b, n);
+        result.evaluations = static_cast<int64_t>(n + n % 2) + 1;
+        break;
+    case INTEGRATION_GAUSS_LEGENDRE:
+        result.value = integration::gauss_legendre(f, a, b, request.order, n);
+        result.evaluations = static_cast<int64_t>(request.order) * n;
+        break;
+    case INTEGRATION_GAUSS_KRONROD:
+        store_adaptive(integration::gauss_kronrod(f, a, b, request.tol, 0.0, workspace()), result);
+        break;
+    case INTEGRATION_TANH_SINH:
+        store_adaptive(integration::tanh_sinh(f, a, b, request.tol), result);
+        break;
+    case INTEGRATION_CAUCHY:
+        result.value = integration::cauchy_principal_value(f, a, b, n, request.singularity);
+        result.evaluations = n;
+        break;
+    case INTEGRATION_PRINCIPAL_VALUE:
+        store_adaptive(integration::principal_value(f, a, b, request.singularity, request.tol,
+                                                    0.0, workspace()),
+                       result);
+        break;
+    default:
+        return INTEGRATION_UNKNOWN_RULE;
+    }
+    return INTEGRATION_OK;
+}
+
+// integrate с исключениями, переведёнными в коды состояния: рабочая память
+// и таблицы узлов выделяются при первом вызове в потоке
+template <typename Function>
+integration_status guarded_integrate(const Function& f, const integration_request& request,
+                                     integration_result& result) {
+    try {
+        return integrate(f, request, result);
+    } catch (const std::bad_alloc&) {
+        return INTEGRATION_OUT_OF_MEMORY;
+    } catch (...) {
+        return INTEGRATION_INTERNAL_ERROR;
+    }
+}
+
+} // namespace
+
+extern "C" {
+
+integration_request integration_default_request(integration_rule rule, double a, double b) {
+    integration_request request;
+    request.rule = rule;
+    request.a = a;
+    request.b = b;
+    request.n = 1000;
+    request.order = 16;
+    request.tol = 1e-10;
+    request.singularity = std::numeric_limits<double>::quiet_NaN();
+    return request;
+}
+
+integration_status integration_rule_by_name(const char* name, integration_rule* rule) {
+    if (!name || !rule) {
+        return INTEGRATION_INVALID_ARGUMENT;
+    }
+    for (int i = 0; i < 9; i++) {
+        if (std::strcmp(name, rule_names[i]) == 0) {
+            *rule = static_cast<integration_rule>(i);
+            return INTEGRATION_OK;
+        }
+    }
+    return INTEGRATION_UNKNOWN_RULE;
+}
+
+integration_status integration_integrate(integration_function function,
+                                         const integration_request* request,
+                                         integration_result* result) {
+    if (!request || !result) {
+        return INTEGRATION_INVALID_ARGUMENT;
+    }
+    switch (function) {
+    case INTEGRATION_RATIONAL: return guarded_integrate(rational_function{}, *request, *result);
+    case INTEGRATION_SINE: return guarded_integrate(sine_function{}, *request, *result);
+    case INTEGRATION_INVERSE_ROOT:
+        return guarded_integrate(inverse_root_function{}, *request, *result);
+    case INTEGRATION_SECANT: return guarded_integrate(secant_function{}, *request, *result);
+    default: return INTEGRATION_UNKNOWN_FUNCTION;
+    }
+}
+
+integration_status integration_integrate_callback(integration_callback callback, void* context,
+                                                  const integration_request* request,
+                                                  integration_result* result) {
+    if (!callback || !request || !result) {
+        return INTEGRATION_INVALID_ARGUMENT;
+    }
+    return guarded_integrate(callback_function{callback, context}, *request, *result);
+}
+
+integration_status integration_integrate_batch(integration_function function,
+                                               const integration_request* requests,
+                                               integration_result* results, size_t count) {
+    if (count > 0 && (!requests || !results)) {
+        return INTEGRATION_INVALID_ARGUMENT;
+    }
+    integration_status first = INTEGRATION_OK;
+    for (size_t i = 0; i < count; i++) {
+        integration_status status = integration_integrate(function, &requests[i], &results[i]);
+        if (first == INTEGRATION_OK) {
+            first = status;
+        }
+    }
+    return first;
+}
+
+const char* integration_status_message(integration_status status) {
+    switch (status) {
+    case INTEGRATION_OK: return "успешно";
+    case INTEGRATION_INVALID_ARGUMENT: return "некорректный аргумент";
+    case INTEGRATION_UNKNOWN_RULE: return "неизвестное правило";
+    case INTEGRATION_UNKNOWN_FUNCTION: return "неизвестная функция";
+    case INTEGRATION_OUT_OF_MEMORY: return "не хватает памяти";
+    case INTEGRATION_INTERNAL_ERROR: return "внутренняя ошибка";
+    }
+    return "неизвестный код состояния";
+}
+
+} // extern "C"
@@ -0,0 +1,320 @@
+#include <iostream>
+#include <iomanip>
+#include <cmath>
+#include <string>
+#include <limits> // For numeric_limits
+
+#include "../include/function.h"
+#include "../include/integration.h"
+#include "../include/gauss_legendre.h"
+#include "../include/tanh_sinh.h"
+#include "../include/principal_value.h"
+#include "../include/rational.h"
+#include "../include/partial_fractions.h"
+#include "../include/sweep.h"
+#include "../include/dual.h"
+#include "../include/service.h"
+#include "../include/output.h"
+#include "../include/integration_c.h"
+
+using namespace std;
+
+// Подынтегральная функция и её первообразная
+const rational_function f;        // Функция f(x) = 1/(x^2 + 4x + 3)
+// Та же функция в виде коэффициентов 1 / (3 + 4x + x^2): полюса находятся автоматически
+const integration::rational f_coefficients({1.0}, {3.0, 4.0, 1.0});
+// Первообразная F(x) = 1/2 * ln|(x+1)/(x+3)| из разложения на простейшие дроби
+const integration::partial_fractions F(f_coefficients);
+
+// Предварительные объявления функций
+double exact_integral(double a, double b); // Точное значение интеграла по формуле Ньютона-Лейбница
+int has_singularity(double a, double b); // Проверка наличия особенности на интервале
+double exact_principal_value(double a, double b, double singularity); // Точное вычисление главного значения по Коши
+void write_tables(integration::output_format format, int rows); // Таблицы заданий 4 и 5 в машинном формате
+int integrate_once(int argc, char* argv[]); // Один интеграл через C-интерфейс libintegration
+
+int main(int argc, char* argv[]) {
+    
+    const int n = 7;
+    const int m = 10;
+    double A[2] = {0.0, 1.0}; // по условию задания 
+    double B[2] = {-1, 0}; 
+    double C[2] = {-2, 0};
+
+    // Долгоживущий режим: запросы JSON-строками на stdin или в Unix-сокет,
+    // ответы - тоже JSON-строками (протокол описан в include/service.h).
+    // --format: только таблицы заданий 4 и 5 (k = 2..rows) в csv, jsonl или binary
+    // --integrate: один интеграл встроенной функции, ответ - одной строкой
+    if (argc > 1) {
+        string mode = argv[1];
+        integration::output_format format;
+        if (mode == "--interactive") {
+            integration::service server;
+            server.serve(stdin, stdout);
+            return 0;
+        }
+        if (mode == "--socket" && argc > 2) {
+            integration::service server;
+            return server.serve_socket(argv[2]) ? 0 : 1;
+        }
+        if (mode == "--format" && argc > 2 && integration::parse_output_format(argv[2], format)) {
+            int rows = (argc > 4 && string(argv[3]) == "--rows") ? atoi(argv[4]) : m;
+            write_tables(format, rows);
+            return 0;
+        }
+        if (mode == "--integrate" && argc > 5) {
+            return integrate_once(argc - 2, argv + 2);
+        }
+        cerr << "Использование: " << argv[0] << " [--interactive | --socket путь |"
+             << " --format table|csv|jsonl|binary [--rows k] |"
+             << " --integrate функция правило a b [n=.. order=.. tol=.. pole=..]]" << endl;
+        return 2;
+    }
+    
+    cout << "ЧИСЛЕННОЕ ИНТЕГРИРОВАНИЕ\n";
+    cout << "Функция: f(x) = 1/(x^2 + 4x + 3)\n";
+    cout << "Параметры: n = " << n << ", m = " << m << "\n";
+    
+    // Задание 1: Точное значение интеграла на [0, 1]
+    INTEGRATION_TASK("задание 1");
+    cout << "ЗАДАНИЕ 1: Точное значение интеграла на интервале A = [0, 1]" << endl;
+    cout << "Функция: f(x) = 1/(x^2 + 4x + 3)\n";
+    cout << "Первообразная: F(x) = 1/2 * ln|(x+1)/(x+3)|\n";
+    cout << "Интервал: [" << A[0] << ", " << A[1] << "]\n\n";
+    
+    double result1 = exact_integral(A[0], A[1]);
+
+    cout << "Точное значение интеграла: " << result1 << endl;
+
+    cout << endl;     
+    // Задание 2: Левое правило
+    INTEGRATION_TASK("задание 2");
+    cout << "ЗАДАНИЕ 2: Левое правило для n узлов" << endl;
+    cout << "Интервал: [" << A[0] << ", " << A[1] << "]" << endl;
+    cout << "Количество узлов: n = " << n << "\n\n";
+    
+    // Задания 2 и 3 используют одни и те же n частей отрезка A: значения f
+    // вычисляются один раз на сетке h/2, из них получаются все правила сразу
+    integration::rule_estimates rules = integration::fused_rules(f, A[0], A[1], n);
+
+    double result2 = rules.left;
+    if (!isnan(result2)) {
+        cout << "Результат по левому правилу: " << result2 << endl;
+    }
+
+    cout << endl;
+    
+    // Задание 3: Правило средних точек
+    INTEGRATION_TASK("задание 3");
+    cout << "ЗАДАНИЕ 3: Правило средних точек для n узлов" << endl;
+    cout << "Интервал: [" << A[0] << ", " << A[1] << "]" << endl;
+    cout << "Количество узлов: n = " << n << "\n\n";
+    
+    double result3 = rules.midpoint;
+    cout << "Результат (средние точки):  " << result3 << "\n";
+    cout << "Симпсон по тем же значениям: " << rules.simpson
+         << " (вычислений функции: " << rules.evaluations << ")\n";
+
+    // Для сравнения: квадратура Гаусса-Лежандра по тем же n узлам (таблица готова при компиляции)
+    double result3_gauss = integration::gauss_legendre<n>(f, A[0], A[1]);
+    cout << "Гаусс-Лежандр по n узлам:   " << result3_gauss << "\n";
+
+    cout << endl;
+    
+    // Задание 4: Особенности на [-1, 0] 
+    INTEGRATION_TASK("задание 4");
+    cout << "ЗАДАНИЕ 4: Особенности на B = [-1, 0] и отсутствие сходимости" << endl;
+    cout << "Интервал: [" << B[0] << ", " << B[1] << "]\n";
+    
+    if (has_singularity(B[0], B[1])) {
+        cout << "ПОДТВЕРЖДЕНО: На интервале есть особенность!\n\n";
+    }
+    
+    cout << "Демонстрация отсутствия сходимости метода трапеций:\n";
+    
+    // Значения для всех k считаются параллельно (вложенные сетки k, 2k, 4k, ...
+    // - одной цепочкой удвоений), строки выводятся по порядку k
+    // через буфер include/output.h
+    {
+        integration::table_writer table(integration::output_format::table,
+            {{"n", integration::column_style::integer, 10, 0},
+             {"Значение интеграла", integration::column_style::fixed, 20, 6}});
+        table.set_nan_text("NaN (ошибка)");
+        integration::trapezoid_sweep(f, B[0], B[1], integration::linear_counts(2, m),
+                                     [&](int k, double integral) { table.row({double(k), integral}); });
+    }
+
+    // Проверка методом tanh-sinh: узлы сгущаются к концам, и если вклад
+    // крайних узлов не убывает, метод сообщает о расходимости явно
+    integration::tanh_sinh_result check = integration::tanh_sinh(f, B[0], B[1], 1e-10);
+    if (check.diverged) {
+        cout << "Метод tanh-sinh: интеграл расходится (вычислений функции: "
+             << check.evaluations << ")\n";
+    } else {
+        cout << "Метод tanh-sinh: " << check.value << "\n";
+    }
+
+    // Задание 5: Главное значение интеграла по Коши на интервале C = [-2, 0]
+    cout << endl;
+    INTEGRATION_TASK("задание 5");
+    cout << "ЗАДАНИЕ 5: Главное значение интеграла по Коши на интервале C = [-2, 0]" << endl;
+    double singularity = integration::poles_in(f_coefficients, C[0], C[1]).front();
+    cout << "Особенность находится в точке x = " << defaultfloat << singularity << endl;
+    cout << "Формула: PV = lim(ε→0+) [∫[-2,-1-ε] f(x)dx + ∫[-1+ε,0] f(x)dx]\n\n";
+    
+    // Точное значение главного значения
+    double exact_pv = exact_principal_value(C[0], C[1], singularity);
+    cout << "Точное главное значение: " << fixed << setprecision(10) << exact_pv << endl;
+    
+    // Показываем сходимость численного метода при увеличении числа узлов
+    cout << "\nСходимость численного метода:\n";
+    {
+        integration::table_writer table(integration::output_format::table,
+            {{"m (узлов)", integration::column_style::integer, 10, 0},
+             {"Численное значение", integration::column_style::fixed, 25, 10},
+             {"Абсолютная погрешность", integration::column_style::scientific, 20, 6}});
+        integration::sweep(integration::linear_counts(2, m),
+                           [&](int k) {
+                               return integration::cauchy_principal_value(f, C[0], C[1], k, singularity);
+                           },
+                           [&](int k, double numerical_pv) {
+            table.row({double(k), numerical_pv, abs(numerical_pv - exact_pv)});
+        });
+    }
+
+    // Симметричные пары узлов Гаусса вокруг особенности: вклад полюса
+    // сокращается в каждой паре, точное значение служит только проверкой
+    integration::adaptive_result pv = integration::principal_value(
+        f, C[0], C[1], integration::poles_in(f_coefficients, C[0], C[1]));
+    cout << "\nСимметричные пары узлов Гаусса:\n";
+    cout << "Численное значение: " << fixed << setprecision(10) << pv.value << "\n";
+    cout << "Абсолютная погрешность: " << scientific << setprecision(6)
+         << abs(pv.value - exact_pv) << "\n";
+    cout << "Вычислений функции: " << pv.evaluations << "\n";
+
+    // Чувствительность к коэффициентам: I(p, q) = ∫ 1/(x^2 + p x + q) dx на A.
+    // p и q - дуальные числа, поэтому один проход квадратуры по тем же
+    // n узлам даёт интеграл и обе производные. Точные значения при p = 4, q = 3:
+    //   dI/dp = -∫ x/(x^2 + 4x + 3)^2 dx = 3/16 - ln(3/2)/2
+    //   dI/dq = -∫ 1/(x^2 + 4x + 3)^2 dx = ln(3/2)/4 - 7/48
+    INTEGRATION_TASK("чувствительность");
+    using gradient = integration::dual<2>;
+    const gradient p = gradient::variable(4.0, 0);
+    const gradient q = gradient::variable(3.0, 1);
+    gradient sensitivity = integration::gauss_legendre<n>(
+        [&](double x) { return 1.0 / (x * x + p * x + q); }, A[0], A[1]);
+    double exact_dp = 3.0 / 16 - log(1.5) / 2;
+    double exact_dq = log(1.5) / 4 - 7.0 / 48;
+    cout << "\nЧУВСТВИТЕЛЬНОСТЬ К КОЭФФИЦИЕНТАМ x^2 + p x + q (p = 4, q = 3):\n";
+    cout << "Интеграл на [" << defaultfloat << A[0] << ", " << A[1] << "]: " << fixed << setprecision(10)
+         << sensitivity.value << "\n";
+    cout << "dI/dp: " << sensitivity.gradient[0] << " (погрешность " << scientific
+         << setprecision(2) << abs(sensitivity.gradient[0] - exact_dp) << ")\n";
+    cout << "dI/dq: " << fixed << setprecision(10) << sensitivity.gradient[1]
+         << " (погрешность " << scientific << setprecision(2)
+         << abs(sensitivity.gradient[1] - exact_dq) << ")\n";
+    INTEGRATION_TASK_END();
+    
+    return 0;
+}
+
+// Таблицы заданий 4 (трапеции на B) и 5 (главное значение на C) для k = 2..rows
+// одной таблицей: task, n, value, error (у задания 4 точного значения нет - NaN)
+void write_tables(integration::output_format format, int rows) {
+    const double B[2] = {-1, 0};
+    const double C[2] = {-2, 0};
+    const double singularity = -1.0;
+    const double exact_pv = exact_principal_value(C[0], C[1], singularity);
+    const double no_value = numeric_limits<double>::quiet_NaN();
+    const std::vector<int> counts = integration::linear_counts(2, rows);
+
+    integration::table_writer table(format,
+        {{"task", integration::column_style::integer, 4, 0},
+         {"n", integration::column_style::integer, 10, 0},
+         {"value", integration::column_style::fixed, 25, 10},
+         {"error", integration::column_style::scientific, 20, 6}});
+    integration::trapezoid_sweep(f, B[0], B[1], counts, [&](int k, double integral) {
+        table.row({4.0, double(k), integral, no_value});
+    });
+    integration::sweep(counts,
+                       [&](int k) {
+                           return integration::cauchy_principal_value(f, C[0], C[1], k, singularity);
+                       },
+                       [&](int k, double numerical_pv) {
+        table.row({5.0, double(k), numerical_pv, abs(numerical_pv - exact_pv)});
+    });
+}
+
+// argv: функция, правило, a, b и необязательные n=, order=, tol=, pole=.
+// Печатает значение, оценку погрешности и число вычислений функции
+int integrate_once(int argc, char* argv[]) {
+    integration_function function;
+    integration_rule rule;
+    integration_status status = integration_function_by_name(argv[0], &function);
+    if (status == INTEGRATION_OK) {
+        status = integration_rule_by_name(argv[1], &rule);
+    }
+    if (status != INTEGRATION_OK) {
+        cerr << integration_status_message(status) << endl;
+        return 2;
+    }
+
+    integration_request request = integration_default_request(rule, atof(argv[2]), atof(argv[3]));
+    for (int i = 4; i < argc; i++) {
+        string option = argv[i];
+        size_t equals = option.find('=');
+        string name = option.substr(0, equals);
+        double value = equals == string::npos ? 0.0 : atof(option.c_str() + equals + 1);
+        // Целые вне диапазона int - заведомо некорректное значение (0)
+        int count = value >= 1.0 && value <= numeric_limits<int>::max() ? int(value) : 0;
+        if (name == "n") {
+            request.n = count;
+        } else if (name == "order") {
+            request.order = count;
+        } else if (name == "tol") {
+            request.tol = value;
+        } else if (name == "pole") {
+            request.singularity = value;
+        } else {
+            cerr << "Неизвестный параметр: " << option << endl;
+            return 2;
+        }
+    }
+
+    integration_result result;
+    status = integration_integrate(function, &request, &result);
+    if (status != INTEGRATION_OK) {
+        cerr << integration_status_message(status) << endl;
+        return 1;
+    }
+    cout << setprecision(17) << result.value << " " << setprecision(6) << result.error << " "
+         << result.evaluations << (result.converged ? "" : " (точность не достигнута)") << "\n";
+    return result.converged ? 0 : 1;
+}
+
+// Точное значение интеграла по формуле Ньютона-Лейбница
+double exact_integral(double a, double b) {
+    double Fa = F(a);
+    double Fb = F(b);
+    return Fb - Fa;
+}
+
+// Проверка наличия особенности на интервале (полюса - корни знаменателя)
+int has_singularity(double a, double b) {
+    double epsilon = 1e-10;
+    return integration::poles_in(f_coefficients, a, b, epsilon).empty() ? 0 : 1;
+}
+
+// Точное вычисление главного значения по Коши через первообразную
+double exact_principal_value(double a, double b, double singularity) {
+    // Если особенность вне интервала, вычисляем обычный интеграл
+    if (singularity <= a || singularity >= b) {
+        return exact_integral(a, b);
+    }
+    
+    // Главное значение: PV = lim(ε→0+) [∫[a, singularity-ε] + ∫[singularity+ε, b]]
+    // Для простого полюса вклад A ln|x - singularity| в первообразную чётен
+    // относительно полюса, поэтому lim(ε→0+) [F(singularity-ε) - F(singularity+ε)] = 0
+    // и PV = F(b) - F(a)
+    return F.principal_value(a, b);
+}